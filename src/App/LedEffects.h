@@ -35,17 +35,25 @@ class SolidEffect: public Effect {
   uint8_t dim() override {return _1D;}
   const char * tags() override {return "💡";}
 
+  struct Controls {
+    uint8_t red = 182;
+    uint8_t green = 15;
+    uint8_t blue = 98;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
-    ui->initSlider(parentVar, "red", leds.effectData.write<uint8_t>(182));
-    ui->initSlider(parentVar, "green", leds.effectData.write<uint8_t>(15));
-    ui->initSlider(parentVar, "blue", leds.effectData.write<uint8_t>(98));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "red", &controls.red);
+    ui->initSlider(parentVar, "green", &controls.green);
+    ui->initSlider(parentVar, "blue", &controls.blue);
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t red = leds.effectData.read<uint8_t>();
-    uint8_t green = leds.effectData.read<uint8_t>();
-    uint8_t blue = leds.effectData.read<uint8_t>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t red = controls.red;
+    uint8_t green = controls.green;
+    uint8_t blue = controls.blue;
 
     CRGB color = CRGB(red, green, blue);
     leds.fill_solid(color);
@@ -139,14 +147,14 @@ class FlowEffect: public Effect {
     uint16_t zoneLen = leds.size.x / zones;
     uint16_t offset  = (leds.size.x - zones * zoneLen) >> 1;
 
-    leds.fill_solid(ColorFromPalette(leds.palette, -counter));
+    leds.fill_solid(leds.colorFromPalette(-counter));
 
     for (int z = 0; z < zones; z++) {
       uint16_t pos = offset + z * zoneLen;
       for (int i = 0; i < zoneLen; i++) {
         uint8_t  colorIndex = (i * 255 / zoneLen) - counter;
         uint16_t led = (z & 0x01) ? i : (zoneLen -1) -i;
-        leds[pos + led] = ColorFromPalette(leds.palette, colorIndex);
+        leds[pos + led] = leds.colorFromPalette(colorIndex);
       }
     }
   }
@@ -202,7 +210,7 @@ class BPMEffect: public Effect {
     uint8_t BeatsPerMinute = 62;
     uint8_t beat = beatsin8( BeatsPerMinute, 64, 255);
     for (uint16_t i = 0; i < leds.size.x; i++) { //9948
-      leds[i] = ColorFromPalette(leds.palette, sys->now/50+(i*2), beat-sys->now/50+(i*10));
+      leds[i] = leds.colorFromPalette(sys->now/50+(i*2), beat-sys->now/50+(i*10));
     }
   }
 };
@@ -356,7 +364,7 @@ class BouncingBallsEffect: public Effect {
 
       int pos = roundf(balls[i].height * (leds.size.x - 1));
 
-      CRGB color = ColorFromPalette(leds.palette, i*(256/max(numBalls, (uint8_t)8))); //error: no matching function for call to 'max(uint8_t&, int)'
+      CRGB color = leds.colorFromPalette(i*(256/max(numBalls, (uint8_t)8))); //error: no matching function for call to 'max(uint8_t&, int)'
 
       leds[pos] = color;
       // if (leds.size.x<32) leds.setPixelColor(indexToVStrip(pos, stripNr), color); // encode virtual strip into index
@@ -414,9 +422,9 @@ void mode_fireworks(LedsLayer &leds, uint16_t *aux0, uint16_t *aux1, uint8_t spe
       if(random8(my_intensity) == 0) {
         uint16_t index = random(leds.size.x);
         if (soundColor < 0)
-          leds.setPixelColor(index, ColorFromPalette(leds.palette, random8()));
+          leds.setPixelColor(index, leds.colorFromPalette(random8()));
         else
-          leds.setPixelColor(index, ColorFromPalette(leds.palette, soundColor + random8(24))); // WLEDSR
+          leds.setPixelColor(index, leds.colorFromPalette(soundColor + random8(24))); // WLEDSR
         *aux1 = *aux0;
         *aux0 = index;
       }
@@ -494,20 +502,29 @@ class DripEffect: public Effect {
   uint8_t dim() override {return _1D;}
   const char * tags() override {return "💡💫";}
   
+  struct Controls {
+    uint8_t gravity = 128;
+    uint8_t drips = 4;
+    uint8_t swell = 4;
+    bool3State invert = false;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     Effect::setup(leds, parentVar);
-    ui->initSlider(parentVar, "gravity", leds.effectData.write<uint8_t>(128), 1, 255);
-    ui->initSlider(parentVar, "drips", leds.effectData.write<uint8_t>(4), 1, 6);
-    ui->initSlider(parentVar, "swell", leds.effectData.write<uint8_t>(4), 1, 6);
-    ui->initCheckBox(parentVar, "invert", leds.effectData.write<bool3State>(false));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "gravity", &controls.gravity, 1, 255);
+    ui->initSlider(parentVar, "drips", &controls.drips, 1, 6);
+    ui->initSlider(parentVar, "swell", &controls.swell, 1, 6);
+    ui->initCheckBox(parentVar, "invert", &controls.invert);
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t grav = leds.effectData.read<uint8_t>();
-    uint8_t drips = leds.effectData.read<uint8_t>();
-    uint8_t swell = leds.effectData.read<uint8_t>();
-    bool3State invert = leds.effectData.read<bool3State>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t grav = controls.gravity;
+    uint8_t drips = controls.drips;
+    uint8_t swell = controls.swell;
+    bool3State invert = controls.invert;
 
     //binding of loop persistent values (pointers)
     Spark* drops = leds.effectData.readWrite<Spark>(maxNumDrops);
@@ -525,7 +542,7 @@ class DripEffect: public Effect {
         drops[j].vel = 0;           // speed
         drops[j].col = sourcedrop;  // brightness
         drops[j].colIndex = 1;      // drop state (0 init, 1 forming, 2 falling, 5 bouncing)
-        drops[j].velX = (uint32_t)ColorFromPalette(leds.palette, random8()); // random color
+        drops[j].velX = (uint32_t)leds.colorFromPalette(random8()); // random color
       }
       CRGB dropColor = drops[j].velX;
 
@@ -615,32 +632,44 @@ class HeartBeatEffect: public Effect {
     }
 
     for (int i = 0; i < leds.size.x; i++) {
-      leds.setPixelColor(i, ColorFromPalette(leds.palette, map(i, 0, leds.size.x, 0, 255), 255 - (*bri_lower >> 8)));
+      leds.setPixelColor(i, leds.colorFromPalette(map(i, 0, leds.size.x, 0, 255), 255 - (*bri_lower >> 8)));
     }
   }
 }; // HeartBeatEffect
 
+#ifdef STARLIGHT_USERMOD_AUDIOSYNC
+
 class FreqMatrixEffect: public Effect {
   const char * name() override {return "FreqMatrix";}
   uint8_t dim() override {return _1D;}
   const char * tags() override {return "♪💡";}
 
+  struct Controls {
+    uint8_t speed = 255;
+    uint8_t soundEffect = 128;
+    uint8_t lowBin = 18;
+    uint8_t highBin = 48;
+    uint8_t sensivity = 30;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     leds.fadeToBlackBy(16);
-    ui->initSlider(parentVar, "speed", leds.effectData.write<uint8_t>(255));
-    ui->initSlider(parentVar, "soundEffect", leds.effectData.write<uint8_t>(128));
-    ui->initSlider(parentVar, "lowBin", leds.effectData.write<uint8_t>(18));
-    ui->initSlider(parentVar, "highBin", leds.effectData.write<uint8_t>(48));
-    ui->initSlider(parentVar, "sensivity", leds.effectData.write<uint8_t>(30), 10, 100);
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "speed", &controls.speed);
+    ui->initSlider(parentVar, "soundEffect", &controls.soundEffect);
+    ui->initSlider(parentVar, "lowBin", &controls.lowBin);
+    ui->initSlider(parentVar, "highBin", &controls.highBin);
+    ui->initSlider(parentVar, "sensivity", &controls.sensivity, 10, 100);
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t speed = leds.effectData.read<uint8_t>();
-    uint8_t fx = leds.effectData.read<uint8_t>();
-    uint8_t lowBin = leds.effectData.read<uint8_t>();
-    uint8_t highBin = leds.effectData.read<uint8_t>();
-    uint8_t sensitivity10 = leds.effectData.read<uint8_t>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t speed = controls.speed;
+    uint8_t fx = controls.soundEffect;
+    uint8_t lowBin = controls.lowBin;
+    uint8_t highBin = controls.highBin;
+    uint8_t sensitivity10 = controls.sensivity;
 
     //binding of loop persistent values (pointers) tbd: aux0,1,step etc can be renamed to meaningful names
     uint8_t *aux0 = leds.effectData.readWrite<uint8_t>();
@@ -680,6 +709,8 @@ class FreqMatrixEffect: public Effect {
 
 };
 
+#endif //STARLIGHT_USERMOD_AUDIOSYNC
+
 #define maxNumPopcorn 21 // max 21 on 16 segment ESP8266
 #define NUM_COLORS       3 /* number of colors per segment */
 
@@ -754,13 +785,15 @@ class PopCornEffect: public Effect {
         // uint32_t col = leds.color_wheel(popcorn[i].colIndex);
         // if (!leds.palette && popcorn[i].colIndex < NUM_COLORS) col = SEGCOLOR(popcorn[i].colIndex);
         uint16_t ledIndex = popcorn[i].pos;
-        CRGB col = ColorFromPalette(leds.palette, popcorn[i].colIndex*(256/maxNumPopcorn));
+        CRGB col = leds.colorFromPalette(popcorn[i].colIndex*(256/maxNumPopcorn));
         if (ledIndex < leds.size.x) leds.setPixelColor(ledIndex, col);
       }
     }
   }
 }; //PopCorn
 
+#ifdef STARLIGHT_USERMOD_AUDIOSYNC
+
 class NoiseMeterEffect: public Effect {
   const char * name() override {return "NoiseMeter";}
   uint8_t dim() override {return _1D;}
@@ -790,7 +823,7 @@ class NoiseMeterEffect: public Effect {
 
     for (int i=0; i<maxLen; i++) {                                    // The louder the sound, the wider the soundbar. By Andrew Tuline.
       uint8_t index = inoise8(i * audioSync->sync.volumeSmth + (*aux0), (*aux1) + i * audioSync->sync.volumeSmth);  // Get a value from the noise function. I'm using both x and y axis.
-      leds.setPixelColor(i, ColorFromPalette(leds.palette, index));//, 255, PALETTE_SOLID_WRAP));
+      leds.setPixelColor(i, leds.colorFromPalette(index));//, 255, PALETTE_SOLID_WRAP));
     }
 
     *aux0+=beatsin8(5,0,10);
@@ -827,7 +860,7 @@ class AudioRingsEffect: public RingEffect {
       }
   
       // Visualize leds to the beat
-      CRGB color = ColorFromPalette(leds.palette, val, val);
+      CRGB color = leds.colorFromPalette(val, val);
 //      CRGB color = ColorFromPalette(currentPalette, val, 255, currentBlending);
 //      color.nscale8_video(val);
       setRing(leds, i, color);
@@ -841,7 +874,7 @@ class AudioRingsEffect: public RingEffect {
   void setRingFromFtt(LedsLayer &leds, int index, int ring) {
     byte val = audioSync->fftResults[index];
     // Visualize leds to the beat
-    CRGB color = ColorFromPalette(leds.palette, val);
+    CRGB color = leds.colorFromPalette(val);
     color.nscale8_video(val);
     setRing(leds, ring, color);
   }
@@ -922,6 +955,8 @@ class DJLightEffect: public Effect {
   }
 }; //DJLight
 
+#endif //STARLIGHT_USERMOD_AUDIOSYNC
+
 
 
 
@@ -994,21 +1029,31 @@ class BlackHoleEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "💡";}
   
+  struct Controls {
+    uint8_t fade = 16;
+    uint8_t outX = 16;
+    uint8_t outY = 16;
+    uint8_t inX = 16;
+    uint8_t inY = 16;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
-    ui->initSlider(parentVar, "fade", leds.effectData.write<uint8_t>(16), 0, 32);
-    ui->initSlider(parentVar, "outX", leds.effectData.write<uint8_t>(16), 0, 32);
-    ui->initSlider(parentVar, "outY", leds.effectData.write<uint8_t>(16), 0, 32);
-    ui->initSlider(parentVar, "inX", leds.effectData.write<uint8_t>(16), 0, 32);
-    ui->initSlider(parentVar, "inY", leds.effectData.write<uint8_t>(16), 0, 32);
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "fade", &controls.fade, 0, 32);
+    ui->initSlider(parentVar, "outX", &controls.outX, 0, 32);
+    ui->initSlider(parentVar, "outY", &controls.outY, 0, 32);
+    ui->initSlider(parentVar, "inX", &controls.inX, 0, 32);
+    ui->initSlider(parentVar, "inY", &controls.inY, 0, 32);
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t fade = leds.effectData.read<uint8_t>();
-    uint8_t outX = leds.effectData.read<uint8_t>();
-    uint8_t outY = leds.effectData.read<uint8_t>();
-    uint8_t inX = leds.effectData.read<uint8_t>();
-    uint8_t inY = leds.effectData.read<uint8_t>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t fade = controls.fade;
+    uint8_t outX = controls.outX;
+    uint8_t outY = controls.outY;
+    uint8_t inX = controls.inX;
+    uint8_t inY = controls.inY;
 
     uint16_t x, y;
 
@@ -1076,11 +1121,11 @@ class DNAEffect: public Effect {
       int posY1 = beatsin8(speed, 0, rows-1, 0, phase    );
       int posY2 = beatsin8(speed, 0, rows-1, 0, phase + 128);
       if ((i==0) || ((abs(lastY1 - posY1) < 2) && (abs(lastY2 - posY2) < 2))) {   // use original code when no holes
-        leds.setPixelColor(i, posY1, ColorFromPalette(leds.palette, i*5+sys->now/17, beatsin8(5, 55, 255, 0, i*10)));
-        leds.setPixelColor(i, posY2, ColorFromPalette(leds.palette, i*5+128+sys->now/17, beatsin8(5, 55, 255, 0, i*10+128)));
+        leds.setPixelColor(i, posY1, leds.colorFromPalette(i*5+sys->now/17, beatsin8(5, 55, 255, 0, i*10)));
+        leds.setPixelColor(i, posY2, leds.colorFromPalette(i*5+128+sys->now/17, beatsin8(5, 55, 255, 0, i*10+128)));
       } else {                                                                    // draw line to prevent holes
-        leds.drawLine(i-1, lastY1, i, posY1, ColorFromPalette(leds.palette, i*5+sys->now/17, beatsin8(5, 55, 255, 0, i*10)));
-        leds.drawLine(i-1, lastY2, i, posY2, ColorFromPalette(leds.palette, i*5+128+sys->now/17, beatsin8(5, 55, 255, 0, i*10+128)));
+        leds.drawLine(i-1, lastY1, i, posY1, leds.colorFromPalette(i*5+sys->now/17, beatsin8(5, 55, 255, 0, i*10)));
+        leds.drawLine(i-1, lastY2, i, posY2, leds.colorFromPalette(i*5+128+sys->now/17, beatsin8(5, 55, 255, 0, i*10+128)));
       }
       lastY1 = posY1;
       lastY2 = posY2;
@@ -1161,6 +1206,10 @@ class OctopusEffect: public Effect {
     uint8_t radius;
   };
 
+  size_t dataSize(const LedsLayer &leds) override {
+    return SharedData::sizeOf<bool3State, uint8_t, uint8_t, uint8_t, uint8_t, bool3State, Coord3D>(); //controls and prevLedSize, rMap and step follow in their own chunk or block
+  }
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     Effect::setup(leds, parentVar); //palette
     bool3State *setup = leds.effectData.write<bool3State>(true);
@@ -1233,7 +1282,7 @@ class OctopusEffect: public Effect {
             else
               intensity = sin8(sin8((angle * 4 - radius) / 4 + (*step)/2) + radius - (*step) + angle * legs); //octopus
             intensity = intensity * intensity / 255; // add a bit of non-linearity for cleaner display
-            leds[pos] = ColorFromPalette(leds.palette, (*step) / 2 - radius, intensity);
+            leds[pos] = leds.colorFromPalette((*step) / 2 - radius, intensity);
           }
         }
       }
@@ -1272,8 +1321,8 @@ class FireEffect: public Effect {
           int d = ( flareDecay * isqrt((x-j)*(x-j) + (y-i)*(y-i)) + 5 ) / 10;
           uint8_t n = 0;
           if ( z > d ) n = z - d;
-          if ( leds[leds.XY(j, leds.size.y - 1 - i)] < usePalette?ColorFromPalette(leds.palette, n*23): colors[n]) { // can only get brighter
-            leds[leds.XY(j, leds.size.y - 1 - i)] = usePalette?ColorFromPalette(leds.palette, n*23): colors[n]; //23*11 -> within palette range
+          if ( leds[leds.XY(j, leds.size.y - 1 - i)] < usePalette?leds.colorFromPalette(n*23): colors[n]) { // can only get brighter
+            leds[leds.XY(j, leds.size.y - 1 - i)] = usePalette?leds.colorFromPalette(n*23): colors[n]; //23*11 -> within palette range
           }
         }
       }
@@ -1288,23 +1337,33 @@ class FireEffect: public Effect {
     return (largeCandidate*largeCandidate > n) ? smallCandidate : largeCandidate;
   }
 
+  struct Controls {
+    bool3State usePalette = false;
+    uint8_t flareRows = 2;
+    uint8_t maxFlare = 8;
+    uint8_t flareChance = 50;
+    uint8_t flareDecay = 14;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) {
     Effect::setup(leds, parentVar); //palette
 
-    ui->initCheckBox(parentVar, "usePalette",    leds.effectData.write<bool3State>(false));
-    ui->initSlider(parentVar, "flareRows", leds.effectData.write<uint8_t>(2), 0, 5);    /* number of rows (from bottom) allowed to flare */
-    ui->initSlider(parentVar, "maxFlare", leds.effectData.write<uint8_t>(8), 0, 18);     /* max number of simultaneous flares */
-    ui->initSlider(parentVar, "flareChance", leds.effectData.write<uint8_t>(50), 0, 100); /* chance (%) of a new flare (if there's room) */
-    ui->initSlider(parentVar, "flareDecay", leds.effectData.write<uint8_t>(14), 0, 28);  /* decay rate of flare radiation; 14 is good */
+    Controls &controls = leds.initControls<Controls>();
+    ui->initCheckBox(parentVar, "usePalette", &controls.usePalette);
+    ui->initSlider(parentVar, "flareRows", &controls.flareRows, 0, 5);    /* number of rows (from bottom) allowed to flare */
+    ui->initSlider(parentVar, "maxFlare", &controls.maxFlare, 0, 18);     /* max number of simultaneous flares */
+    ui->initSlider(parentVar, "flareChance", &controls.flareChance, 0, 100); /* chance (%) of a new flare (if there's room) */
+    ui->initSlider(parentVar, "flareDecay", &controls.flareDecay, 0, 28);  /* decay rate of flare radiation; 14 is good */
   }
 
   void loop(LedsLayer &leds) {
 
-    bool3State usePalette = leds.effectData.read<bool3State>();
-    uint8_t flareRows = leds.effectData.read<uint8_t>();
-    uint8_t maxFlare = leds.effectData.read<uint8_t>();
-    uint8_t flareChance = leds.effectData.read<uint8_t>();
-    uint8_t flareDecay = leds.effectData.read<uint8_t>();
+    const Controls &controls = leds.controls<Controls>();
+    bool3State usePalette = controls.usePalette;
+    uint8_t flareRows = controls.flareRows;
+    uint8_t maxFlare = controls.maxFlare;
+    uint8_t flareChance = controls.flareChance;
+    uint8_t flareDecay = controls.flareDecay;
 
     // Effect Variables
     uint8_t *nflare = leds.effectData.readWrite<uint8_t>();
@@ -1315,7 +1374,7 @@ class FireEffect: public Effect {
       for (int x=0; x<leds.size.x; ++x ) {
         CRGB n = CRGB::Black;
         if ( leds[leds.XY(x, leds.size.y - y)] != CRGB::Black) {
-          n = leds[leds.XY(x, leds.size.y - y)] - 0; //-0 to force conversion to CRGB
+          n = leds[leds.XY(x, leds.size.y - y)];
           if (n.red > 10) n.red -= 10; else n.red = 0;
           if (n.green > 10) n.green -= 10; else n.green = 0;
           if (n.blue > 10) n.blue -= 10; else n.blue = 0;
@@ -1326,9 +1385,9 @@ class FireEffect: public Effect {
 
     // Heat the bottom row
     for (int x=0; x<leds.size.x; ++x ) {
-      CRGB i = leds[leds.XY(x, leds.size.y - 1 - 0)] - 0; //-0 to force conversion to CRGB
+      CRGB i = leds[leds.XY(x, leds.size.y - 1 - 0)];
       if ( i != CRGB::Black ) {
-        leds[leds.XY(x, leds.size.y - 1 - 0)] = usePalette?ColorFromPalette(leds.palette, random8()): colors[random(NCOLORS-6, NCOLORS-2)];
+        leds[leds.XY(x, leds.size.y - 1 - 0)] = usePalette?leds.colorFromPalette(random8()): colors[random(NCOLORS-6, NCOLORS-2)];
       }
     }
 
@@ -1370,6 +1429,13 @@ class LissajousEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "💡";}
 
+  struct Controls {
+    uint8_t xFrequency = 64;
+    uint8_t fadeRate = 128;
+    uint8_t speed = 128;
+    bool3State smooth = false;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     Effect::setup(leds, parentVar);
 
@@ -1378,18 +1444,20 @@ class LissajousEffect: public Effect {
     // uint8_t *speed = ; 
     // bool *smooth = ; 
 
-    ui->initSlider(parentVar, "xFrequency", leds.effectData.write<uint8_t>(64));
-    ui->initSlider(parentVar, "fadeRate", leds.effectData.write<uint8_t>(128));
-    ui->initSlider(parentVar, "speed", leds.effectData.write<uint8_t>(128));
-    ui->initCheckBox(parentVar, "smooth", leds.effectData.write<bool3State>(false)); //true: not working at the moment
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "xFrequency", &controls.xFrequency);
+    ui->initSlider(parentVar, "fadeRate", &controls.fadeRate);
+    ui->initSlider(parentVar, "speed", &controls.speed);
+    ui->initCheckBox(parentVar, "smooth", &controls.smooth); //true: not working at the moment
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t xFrequency = leds.effectData.read<uint8_t>();
-    uint8_t fadeRate = leds.effectData.read<uint8_t>();
-    uint8_t speed = leds.effectData.read<uint8_t>();
-    bool3State smooth = leds.effectData.read<bool3State>(); 
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t xFrequency = controls.xFrequency;
+    uint8_t fadeRate = controls.fadeRate;
+    uint8_t speed = controls.speed;
+    bool3State smooth = controls.smooth; 
 
     leds.fadeToBlackBy(fadeRate);
 
@@ -1448,7 +1516,7 @@ class FrizzlesEffect: public Effect {
       Coord3D pos = {0,0,0};
       pos.x = beatsin8(bpm/8 + i, 0, leds.size.x - 1);
       pos.y = beatsin8(intensity/8 - i, 0, leds.size.y - 1);
-      CRGB color = ColorFromPalette(leds.palette, beatsin8(12, 0, 255));
+      CRGB color = leds.colorFromPalette(beatsin8(12, 0, 255));
       leds[pos] = color;
     }
     leds.blur2d(blur);
@@ -1572,10 +1640,15 @@ class GameOfLifeEffect: public Effect {
   uint8_t dim() override {return _3D;} //supports 3D but also 2D (1D as well?)
   const char * tags() override {return "💫";}
 
+  size_t dataSize(const LedsLayer &leds) override {
+    return SharedData::sizeOf<bool3State, bool3State, Coord3D, uint8_t, String, uint8_t, uint8_t, uint8_t, bool3State, bool3State, bool3State, bool3State, uint8_t, //controls
+      unsigned long, uint16_t, uint16_t, uint16_t, uint16_t, uint16_t, bool3State, uint16_t, bool3State[9], bool3State[9], CRGB>(); //state, the cell grids follow in their own chunk or block
+  }
+
   void placePentomino(LedsLayer &leds, byte *futureCells, bool colorByAge) {
     byte pattern[5][2] = {{1, 0}, {0, 1}, {1, 1}, {2, 1}, {2, 2}}; // R-pentomino
     if (!random8(5)) pattern[0][1] = 3; // 1/5 chance to use glider
-    CRGB color = ColorFromPalette(leds.palette, random8());
+    CRGB color = leds.colorFromPalette(random8());
     for (int attempts = 0; attempts < 100; attempts++) {
       int x = random8(1, leds.size.x - 3);
       int y = random8(1, leds.size.y - 5);
@@ -1667,12 +1740,12 @@ class GameOfLifeEffect: public Effect {
     byte     *cellColors       = leds.effectData.readWrite<byte>(leds.size.x * leds.size.y * leds.size.z);
 
     CRGB bgColor = CRGB(bgC.x, bgC.y, bgC.z);
-    CRGB color   = ColorFromPalette(leds.palette, random8()); // Used if all parents died
+    CRGB color   = leds.colorFromPalette(random8()); // Used if all parents died
 
     // Start New Game of Life
     if (*setup || (*generation == 0 && *step < sys->now)) {
       *setup = false;
-      *prevPalette = ColorFromPalette(leds.palette, 0);
+      *prevPalette = leds.colorFromPalette(0);
       *generation = 1;
       disablePause ? *step = sys->now : *step = sys->now + 1500;
 
@@ -1686,7 +1759,7 @@ class GameOfLifeEffect: public Effect {
           int index = leds.XYZUnprojected({x,y,z});
           setBitValue(cells, index, true);
           cellColors[index] = random8(1, 255);
-          leds.setPixelColor({x,y,z}, colorByAge ? CRGB::Green : ColorFromPalette(leds.palette, cellColors[index]));
+          leds.setPixelColor({x,y,z}, colorByAge ? CRGB::Green : leds.colorFromPalette(cellColors[index]));
           // leds.setPixelColor({x,y,z}, bgColor); // Color set in redraw loop
         }
       }
@@ -1718,10 +1791,10 @@ class GameOfLifeEffect: public Effect {
         // Redraw alive if palette changed, spawn initial colors randomly, age alive cells while paused
         if      (alive && recolor) {
           cellColors[cIndex] = random8(1, 255);
-          leds.setPixelColor(cLoc, colorByAge ? CRGB::Green : ColorFromPalette(leds.palette, cellColors[cIndex]));
+          leds.setPixelColor(cLoc, colorByAge ? CRGB::Green : leds.colorFromPalette(cellColors[cIndex]));
         }
         else if (alive && colorByAge && !*generation) leds.blendPixelColor(cLoc, CRGB::Red, 248); // Age alive cells while paused
-        else if (alive && cellColors[cIndex] != 0) leds.setPixelColor(cLoc, colorByAge ? CRGB::Green : ColorFromPalette(leds.palette, cellColors[cIndex]));
+        else if (alive && cellColors[cIndex] != 0) leds.setPixelColor(cLoc, colorByAge ? CRGB::Green : leds.colorFromPalette(cellColors[cIndex]));
         // Redraw dead if palette changed, blur paused game, fade on newgame
         // if      (!alive && (paletteChanged || disablePause)) leds.setPixelColor(cLoc, bgColor);   // Remove blended dead cells
         else if (!alive && blurDead)         leds.blendPixelColor(cLoc, bgColor, blur);           // Blend dead cells while paused
@@ -1801,7 +1874,7 @@ class GameOfLifeEffect: public Effect {
         byte colorIndex = nColors[random8(colorCount)];
         if (random8(100) < mutation) colorIndex = random8();
         cellColors[cIndex] = colorIndex;
-        leds.setPixelColor(cPos, colorByAge ? CRGB::Green : ColorFromPalette(leds.palette, colorIndex));
+        leds.setPixelColor(cPos, colorByAge ? CRGB::Green : leds.colorFromPalette(colorIndex));
       }
       else {
         // Blending, fade dead cells further causing blurring effect to moving cells
@@ -1814,7 +1887,7 @@ class GameOfLifeEffect: public Effect {
         }
         else { // alive
           if (colorByAge) leds.blendPixelColor(cPos, CRGB::Red, 248);
-          else leds.setPixelColor(cPos, ColorFromPalette(leds.palette, cellColors[cIndex]));
+          else leds.setPixelColor(cPos, leds.colorFromPalette(cellColors[cIndex]));
         }
       }
     }
@@ -2087,6 +2160,8 @@ class RubiksCubeEffect: public Effect {
 
     typedef void (Cube::*RotateFunc)(bool direction, uint8_t width);
     const RotateFunc rotateFuncs[] = {&Cube::rotateFront, &Cube::rotateBack, &Cube::rotateLeft, &Cube::rotateRight, &Cube::rotateTop, &Cube::rotateBottom};
+
+    if (cubeSize == 0) return; //controls not bound yet (sizing loop of initEffect), cube functions assume 1..MAX_SIZE
     
     if (*setup && sys->now > *step || *step - 3100 > sys->now) { // *step - 3100 > sys->now temp fix for default on boot
       *step = sys->now + 1000;
@@ -2311,7 +2386,7 @@ class ParticleTestEffect: public Effect {
         if (leds.projectionDimension == _3D) particles[index].vz = (random8() / 256.0f) * 2.0f - 1.0f;
         else particles[index].vz = 0;
 
-        particles[index].color = ColorFromPalette(leds.palette, random8());
+        particles[index].color = leds.colorFromPalette(random8());
         Coord3D initPos = particles[index].toCoord3DRounded();
         leds.setPixelColor(initPos, particles[index].color);
       }
@@ -2430,7 +2505,7 @@ class StarFieldEffect: public Effect {  // Inspired by Daniel Shiffman's Coding
 
       Coord3D pos = {int(sx), int(sy), 0};
       if (!pos.isOutofBounds(leds.size)) {
-        if (usePalette) leds.setPixelColor(sx, sy, ColorFromPalette(leds.palette, stars[i].colorIndex, map(stars[i].z, 0, leds.size.x, 255, 150)));
+        if (usePalette) leds.setPixelColor(sx, sy, leds.colorFromPalette(stars[i].colorIndex, map(stars[i].z, 0, leds.size.x, 255, 150)));
         else {
           uint8_t color = map(stars[i].colorIndex, 0, 255, 120, 255);
           int brightness = map(stars[i].z, 0, leds.size.x, 7, 10);
@@ -2457,27 +2532,38 @@ public:
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "💫";}
 
+  struct Controls {
+    uint8_t macroMutatorFreq = 3;
+    uint8_t macroMutatorMin = 250;
+    uint8_t macroMutatorMax = 255;
+    uint8_t microMutatorFreq = 4;
+    uint8_t microMutatorMin = 200;
+    uint8_t microMutatorMax = 255;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     Effect::setup(leds, parentVar);
     //ui->initSlider(parentVar, "hueSpeed", leds.effectData.write<uint8_t>(20), 1, 100); // (14), 1, 255)
     //ui->initSlider(parentVar, "saturation", leds.effectData.write<uint8_t>(255), 0, 255);
-    ui->initSlider(parentVar, "macroMutatorFreq", leds.effectData.write<uint8_t>(3), 0, 15); // (14), 1, 255)
-    ui->initSlider(parentVar, "macroMutatorMin", leds.effectData.write<uint8_t>(250), 250, 255); // (125), 1, 2500)
-    ui->initSlider(parentVar, "macroMutatorMax", leds.effectData.write<uint8_t>(255), 0, 255); // (1), 1, 2500)
-    ui->initSlider(parentVar, "microMutatorFreq", leds.effectData.write<uint8_t>(4), 0, 15); // (128), 1, 255)
-    ui->initSlider(parentVar, "microMutatorMin", leds.effectData.write<uint8_t>(200), 0, 255); // (550), 0, 2500)
-    ui->initSlider(parentVar, "microMutatorMax", leds.effectData.write<uint8_t>(255), 0, 255); // (900), 0, 2500)
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "macroMutatorFreq", &controls.macroMutatorFreq, 0, 15); // (14), 1, 255)
+    ui->initSlider(parentVar, "macroMutatorMin", &controls.macroMutatorMin, 250, 255); // (125), 1, 2500)
+    ui->initSlider(parentVar, "macroMutatorMax", &controls.macroMutatorMax, 0, 255); // (1), 1, 2500)
+    ui->initSlider(parentVar, "microMutatorFreq", &controls.microMutatorFreq, 0, 15); // (128), 1, 255)
+    ui->initSlider(parentVar, "microMutatorMin", &controls.microMutatorMin, 0, 255); // (550), 0, 2500)
+    ui->initSlider(parentVar, "microMutatorMax", &controls.microMutatorMax, 0, 255); // (900), 0, 2500)
   }
 
   void loop(LedsLayer &leds) override {
     //uint8_t huespeed = leds.effectData.read<uint8_t>();
     //uint8_t saturation = leds.effectData.read<uint8_t>(); I will revisit this when I have a display
-    uint8_t macroMutatorFreq = leds.effectData.read<uint8_t>();
-    uint8_t macroMutatorMin = leds.effectData.read<uint8_t>();
-    uint8_t macroMutatorMax = leds.effectData.read<uint8_t>();
-    uint8_t microMutatorFreq = leds.effectData.read<uint8_t>();
-    uint8_t microMutatorMin = leds.effectData.read<uint8_t>();
-    uint8_t microMutatorMax = leds.effectData.read<uint8_t>();
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t macroMutatorFreq = controls.macroMutatorFreq;
+    uint8_t macroMutatorMin = controls.macroMutatorMin;
+    uint8_t macroMutatorMax = controls.macroMutatorMax;
+    uint8_t microMutatorFreq = controls.microMutatorFreq;
+    uint8_t microMutatorMin = controls.microMutatorMin;
+    uint8_t microMutatorMax = controls.microMutatorMax;
 
     uint16_t macro_mutator = beatsin16(macroMutatorFreq, macroMutatorMin << 8, macroMutatorMax << 8); // beatsin16(14, 65350, 65530);
     uint16_t micro_mutator = beatsin16(microMutatorFreq, microMutatorMin, microMutatorMax); // beatsin16(2, 550, 900);
@@ -2492,7 +2578,7 @@ public:
         //uint8_t hue = huebase + (-(pos.x+pos.y)*macro_mutator*10) + ((pos.x+pos.x*pos.y*(macro_mutator*256))/(micro_mutator+1));
         uint8_t hue = huebase + ((pos.x+pos.y*macro_mutator*pos.x)/(micro_mutator+1));
         // uint8_t hue = huebase + ((pos.x+pos.y)*(250-macro_mutator)/5) + ((pos.x+pos.y*macro_mutator*pos.x)/(micro_mutator+1)); Original
-        CRGB colour = ColorFromPalette(leds.palette, hue, 255);
+        CRGB colour = leds.colorFromPalette(hue, 255);
         leds[pos] = colour;// blend(leds.getPixelColor(pos), colour, 155);
       }
     }
@@ -2507,20 +2593,28 @@ class WaverlyEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "♪💡";}
   
+  struct Controls {
+    uint8_t fadeRate = 128;
+    uint8_t amplification = 30;
+    bool3State noClouds = false;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     Effect::setup(leds, parentVar);
-    ui->initSlider(parentVar, "fadeRate", leds.effectData.write<uint8_t>(128));
-    ui->initSlider(parentVar, "amplification", leds.effectData.write<uint8_t>(30));
-    ui->initCheckBox(parentVar, "noClouds", leds.effectData.write<bool3State>(false));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "fadeRate", &controls.fadeRate);
+    ui->initSlider(parentVar, "amplification", &controls.amplification);
+    ui->initCheckBox(parentVar, "noClouds", &controls.noClouds);
     // ui->initCheckBox(parentVar, "soundPressure", leds.effectData.write<bool3State>(false));
     // ui->initCheckBox(parentVar, "AGCDebug", leds.effectData.write<bool3State>(false));
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t fadeRate = leds.effectData.read<uint8_t>();
-    uint8_t amplification = leds.effectData.read<uint8_t>();
-    bool3State noClouds = leds.effectData.read<bool3State>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t fadeRate = controls.fadeRate;
+    uint8_t amplification = controls.amplification;
+    bool3State noClouds = controls.noClouds;
     // bool3State soundPressure = leds.effectData.read<bool3State>();
     // bool3State agcDebug = leds.effectData.read<bool3State>();
 
@@ -2537,7 +2631,7 @@ class WaverlyEffect: public Effect {
       uint16_t thisMax = min(map(thisVal, 0, 512, 0, leds.size.y), (long)leds.size.y);
 
       for (pos.y = 0; pos.y < thisMax; pos.y++) {
-        CRGB color = ColorFromPalette(leds.palette, map(pos.y, 0, thisMax, 250, 0));
+        CRGB color = leds.colorFromPalette(map(pos.y, 0, thisMax, 250, 0));
         if (!noClouds)
           leds.addPixelColor(pos, color);
         leds.addPixelColor((leds.size.x - 1) - pos.x, (leds.size.y - 1) - pos.y, color);
@@ -2552,13 +2646,21 @@ class GEQEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "♫💡";}
 
+  struct Controls {
+    uint8_t fadeOut = 255;
+    uint8_t ripple = 128;
+    bool3State colorBars = false;
+    bool3State smoothBars = true;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     leds.fadeToBlackBy(16);
     Effect::setup(leds, parentVar);
-    ui->initSlider(parentVar, "fadeOut", leds.effectData.write<uint8_t>(255));
-    ui->initSlider(parentVar, "ripple", leds.effectData.write<uint8_t>(128));
-    ui->initCheckBox(parentVar, "colorBars", leds.effectData.write<bool3State>(false));
-    ui->initCheckBox(parentVar, "smoothBars", leds.effectData.write<bool3State>(true));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "fadeOut", &controls.fadeOut);
+    ui->initSlider(parentVar, "ripple", &controls.ripple);
+    ui->initCheckBox(parentVar, "colorBars", &controls.colorBars);
+    ui->initCheckBox(parentVar, "smoothBars", &controls.smoothBars);
 
     // Nice an effect can register it's own DMX channel, but not a fan of repeating the range and type of the param
 
@@ -2576,11 +2678,12 @@ class GEQEffect: public Effect {
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t fadeOut = leds.effectData.read<uint8_t>();
-    uint8_t ripple = leds.effectData.read<uint8_t>();
-    bool3State colorBars = leds.effectData.read<bool3State>();
-    bool3State smoothBars = leds.effectData.read<bool3State>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t fadeOut = controls.fadeOut;
+    uint8_t ripple = controls.ripple;
+    bool3State colorBars = controls.colorBars;
+    bool3State smoothBars = controls.smoothBars;
 
     //binding of loop persistent values (pointers) tbd: aux0,1,step etc can be renamed to meaningful names
     uint16_t *previousBarHeight = leds.effectData.readWrite<uint16_t>(leds.size.x); //array
@@ -2646,7 +2749,7 @@ class GEQEffect: public Effect {
         if (colorBars) //color_vertical / color bars toggle
           colorIndex = map(pos.y, 0, leds.size.y-1, 0, 255);
 
-        ledColor = ColorFromPalette(leds.palette, (uint8_t)colorIndex);
+        ledColor = leds.colorFromPalette((uint8_t)colorIndex);
 
         leds.setPixelColor(pos.x, leds.size.y - 1 - pos.y, ledColor);
       }
@@ -2667,28 +2770,40 @@ class LaserGEQEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "♫💡📺";}
 
+  struct Controls {
+    uint8_t speed = 10;
+    uint8_t frontFill = 228;
+    uint8_t horizon = 0;
+    uint8_t depth = 176;
+    uint8_t numBands = 16;
+    bool3State borders = true;
+    bool3State softHack = true;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     leds.fadeToBlackBy(16);
     Effect::setup(leds, parentVar);
-    ui->initSlider(parentVar, "speed", leds.effectData.write<uint8_t>(10), 1, 10);
-    ui->initSlider(parentVar, "frontFill", leds.effectData.write<uint8_t>(228));
-    ui->initSlider(parentVar, "horizon", leds.effectData.write<uint8_t>(0), 0, leds.size.x-1); //leds.size.x-1 is not always set here
-    ui->initSlider(parentVar, "depth", leds.effectData.write<uint8_t>(176));
-    ui->initSlider(parentVar, "numBands", leds.effectData.write<uint8_t>(16), 2, 16); // constrain NUM_BANDS between 2(for split) and cols (for small width segments)
-    ui->initCheckBox(parentVar, "borders", leds.effectData.write<bool3State>(true));
-    ui->initCheckBox(parentVar, "softHack", leds.effectData.write<bool3State>(true));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "speed", &controls.speed, 1, 10);
+    ui->initSlider(parentVar, "frontFill", &controls.frontFill);
+    ui->initSlider(parentVar, "horizon", &controls.horizon, 0, leds.size.x-1); //leds.size.x-1 is not always set here
+    ui->initSlider(parentVar, "depth", &controls.depth);
+    ui->initSlider(parentVar, "numBands", &controls.numBands, 2, 16); // constrain NUM_BANDS between 2(for split) and cols (for small width segments)
+    ui->initCheckBox(parentVar, "borders", &controls.borders);
+    ui->initCheckBox(parentVar, "softHack", &controls.softHack);
     // "GEQ 3D ☾@Speed,Front Fill,Horizon,Depth,Num Bands,Borders,Soft,;!,,Peaks;!;2f;sx=255,ix=228,c1=255,c2=255,c3=15,pal=11";
   }
 
   void loop(LedsLayer &leds) override {
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t speed = leds.effectData.read<uint8_t>();
-    uint8_t frontFill = leds.effectData.read<uint8_t>();
-    uint8_t horizon = leds.effectData.read<uint8_t>();
-    uint8_t depth = leds.effectData.read<uint8_t>();
-    uint8_t numBands = leds.effectData.read<uint8_t>();
-    bool3State borders = leds.effectData.read<bool3State>();
-    bool3State softHack = leds.effectData.read<bool3State>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t speed = controls.speed;
+    uint8_t frontFill = controls.frontFill;
+    uint8_t horizon = controls.horizon;
+    uint8_t depth = controls.depth;
+    uint8_t numBands = controls.numBands;
+    bool3State borders = controls.borders;
+    bool3State softHack = controls.softHack;
 
     uint16_t *projector = leds.effectData.readWrite<uint16_t>();
     int8_t *projector_dir = leds.effectData.readWrite<int8_t>();
@@ -2720,7 +2835,7 @@ class LaserGEQEffect: public Effect {
 
     for (int i=0; i<=split; i++) { // paint right vertical faces and top - LEFT to RIGHT
       uint16_t colorIndex = map(cols/NUM_BANDS*i, 0, cols-1, 0, 255);
-      CRGB ledColor = ColorFromPalette(leds.palette, colorIndex);
+      CRGB ledColor = leds.colorFromPalette(colorIndex);
       int linex = i*(cols/NUM_BANDS);
 
       if (heights[i] > 1) {
@@ -2745,7 +2860,7 @@ class LaserGEQEffect: public Effect {
 
     for (int i=(NUM_BANDS - 1); i>split; i--) { // paint left vertical faces and top - RIGHT to LEFT
       uint16_t colorIndex = map(cols/NUM_BANDS*i, 0, cols-1, 0, 255);
-      CRGB ledColor = ColorFromPalette(leds.palette, colorIndex);
+      CRGB ledColor = leds.colorFromPalette(colorIndex);
       int linex = i*(cols/NUM_BANDS);
       int pPos = max(0, linex+(cols/NUM_BANDS)-1);
 
@@ -2770,7 +2885,7 @@ class LaserGEQEffect: public Effect {
 
     for (int i=0; i<NUM_BANDS; i++) {
       uint16_t colorIndex = map(cols/NUM_BANDS*i, 0, cols-1, 0, 255);
-      CRGB ledColor = ColorFromPalette(leds.palette, colorIndex);
+      CRGB ledColor = leds.colorFromPalette(colorIndex);
       int linex = i*(cols/NUM_BANDS);
       int pPos  = linex+(cols/NUM_BANDS)-1;
       int pPos1 = linex+(cols/NUM_BANDS);
@@ -2877,9 +2992,9 @@ class PaintbrushEffect: public Effect {
       if (length > max(1, (int)minLength)) {
         CRGB color;
         if (color_chaos)
-          color = ColorFromPalette(leds.palette, i * 255 / numLines + ((*aux0Hue)&0xFF), 255);
+          color = leds.colorFromPalette(i * 255 / numLines + ((*aux0Hue)&0xFF), 255);
         else
-          color = ColorFromPalette(leds.palette, map(i, 0, numLines, 0, 255), 255);
+          color = leds.colorFromPalette(map(i, 0, numLines, 0, 255), 255);
         if (leds.projectionDimension == _3D)
           leds.drawLine3D(x1, y1, z1, x2, y2, z2, color, soft, length); // no soft implemented in 3D yet
         else
@@ -2890,6 +3005,9 @@ class PaintbrushEffect: public Effect {
 
 }; //PaintBrushEffect
 
+#endif //STARLIGHT_USERMOD_AUDIOSYNC, Fireworks is not audio reactive
+
+
 /*
  * Exploding fireworks effect
  * adapted from: http://www.anirama.com/1000leds/1d-fireworks/
@@ -2901,21 +3019,29 @@ class FireworksEffect: public Effect {
   uint8_t dim() override {return _2D;}
   const char * tags() override {return "💡";}
 
+  struct Controls {
+    uint8_t gravity = 128;
+    uint8_t firingSide = 128;
+    uint8_t numSparks = 128;
+  };
+
   void setup(LedsLayer &leds, Variable parentVar) override {
     leds.fadeToBlackBy(16);
     Effect::setup(leds, parentVar);
-    ui->initSlider(parentVar, "gravity", leds.effectData.write<uint8_t>(128));
-    ui->initSlider(parentVar, "firingSide", leds.effectData.write<uint8_t>(128));
-    ui->initSlider(parentVar, "numSparks", leds.effectData.write<uint8_t>(128));
+    Controls &controls = leds.initControls<Controls>();
+    ui->initSlider(parentVar, "gravity", &controls.gravity);
+    ui->initSlider(parentVar, "firingSide", &controls.firingSide);
+    ui->initSlider(parentVar, "numSparks", &controls.numSparks);
     // PROGMEM = "Fireworks 1D@Gravity,Firing side;!,!;!;12;pal=11,ix=128";
   }
 
   void loop(LedsLayer &leds) override {
 
-    //Binding of controls. Keep before binding of vars and keep in same order as in setup()
-    uint8_t gravityC = leds.effectData.read<uint8_t>();
-    uint8_t firingSide = leds.effectData.read<uint8_t>();
-    uint8_t numSparks = leds.effectData.read<uint8_t>();
+    //Binding of controls, typed: no order to keep
+    const Controls &controls = leds.controls<Controls>();
+    uint8_t gravityC = controls.gravity;
+    uint8_t firingSide = controls.firingSide;
+    uint8_t numSparks = controls.numSparks;
 
     float *dying_gravity = leds.effectData.readWrite<float>();
     uint16_t *aux0Flare = leds.effectData.readWrite<uint16_t>();
@@ -3006,7 +3132,7 @@ class FireworksEffect: public Effect {
           if (sparks[i].pos > 0 && sparks[i].pos < rows) {
             if (!(sparks[i].posX >= 0 && sparks[i].posX < cols)) continue;
             uint16_t prog = sparks[i].col;
-            CRGB spColor = ColorFromPalette(leds.palette, sparks[i].colIndex);
+            CRGB spColor = leds.colorFromPalette(sparks[i].colIndex);
             CRGB c = CRGB::Black; //HeatColor(sparks[i].col);
             if (prog > 300) { //fade from white to spark color
               c = CRGB(blend(spColor, CRGB::White, (prog - 300)*5));
@@ -3034,6 +3160,8 @@ class FireworksEffect: public Effect {
 
 }; //FireworksEffect
 
+#ifdef STARLIGHT_USERMOD_AUDIOSYNC
+
 
 class FunkyPlankEffect: public Effect {
   const char * name() override {return "Funky Plank";}
@@ -3090,7 +3218,7 @@ class VUMeterEffect: public Effect {
       int x0 = topLeft.x + size.x / 2; // Center of the needle
       int y0 = topLeft.y + size.y - 1; // Bottom of the needle
 
-      leds.drawCircle(topLeft.x + size.x / 2, topLeft.y + size.y / 2, size.x/2, ColorFromPalette(leds.palette, 35, 128), false);
+      leds.drawCircle(topLeft.x + size.x / 2, topLeft.y + size.y / 2, size.x/2, leds.colorFromPalette(35, 128), false);
 
       // Calculate needle end position
       int x1 = x0 - round(size.y * 0.7 * cos((angle + 30) * PI / 180));
@@ -3120,7 +3248,7 @@ class VUMeterEffect: public Effect {
     for (int h = 0; h < nHorizontal; h++) {
       for (int v = 0; v < nVertical; v++) {
         drawNeedle(leds, (float)audioSync->fftResults[2*(band++)] / 2.0, {leds.size.x * h / nHorizontal, leds.size.y * v / nVertical, 0}, {leds.size.x / nHorizontal, leds.size.y / nVertical, 0}, 
-                ColorFromPalette(leds.palette, 255 / (nHorizontal * nVertical) * band));
+                leds.colorFromPalette(255 / (nHorizontal * nVertical) * band));
       } //audioSync->fftResults[band++] / 200
     }
     // ppf(" v:%f, f:%f", audioSync->volumeSmth, (float) audioSync->fftResults[5]);
@@ -3294,7 +3422,7 @@ class MarioTestEffect: public Effect {
   static LedsLayer *gLeds = nullptr;
   static void _fadeToBlackBy(uint8_t fadeBy) {if (gLeds) gLeds->fadeToBlackBy(fadeBy);}
   static void sPCLive(uint16_t pixel, CRGB color) {if (gLeds) gLeds->setPixelColor(pixel, color);} //setPixelColor with color
-  static void sCFPLive(uint16_t pixel, uint8_t index, uint8_t brightness) {if (gLeds) gLeds->setPixelColor(pixel, ColorFromPalette(gLeds->palette, index, brightness));} //setPixelColor within palette
+  static void sCFPLive(uint16_t pixel, uint8_t index, uint8_t brightness) {if (gLeds) gLeds->setPixelColor(pixel, gLeds->colorFromPalette(index, brightness));} //setPixelColor within palette
 
   //WLED nostalgia
   uint8_t speedControl = 128;
@@ -37,6 +37,37 @@ void fastled_fill_rainbow(struct CRGB * targetArray, int numToFill, uint8_t init
   fill_rainbow(targetArray, numToFill, initialhue, deltahue);
 }
 
+//first quarter of a sine wave, 256 steps (1024 per period), Q15
+static const int16_t sinQuarterQ15[257] = {
+  0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+  3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+  6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+  9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+  12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+  15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+  18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+  20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+  23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+  25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+  27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+  28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+  30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+  31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+  32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+  32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+  32767
+};
+
+int16_t sinQ15(uint16_t angle) {
+  uint16_t step = angle >> 6; //1024 steps per period, the 6 lower bits interpolate
+  uint16_t i = step & 255;
+  int32_t a, b;
+  if (step & 256) {a = sinQuarterQ15[256 - i]; b = sinQuarterQ15[255 - i];} //2nd and 4th quarter: mirrored
+  else {a = sinQuarterQ15[i]; b = sinQuarterQ15[i + 1];}
+  int16_t value = a + (((b - a) * (angle & 63) + 32) >> 6);
+  return step & 512 ? -value : value; //3rd and 4th quarter: negative
+}
+
 void Effect::setup(LedsLayer &leds, Variable parentVar) {
     ui->initSelect(parentVar, "palette", 4, false, [&leds](EventArguments) { switch (eventType) {
       case onUI: {
@@ -69,12 +100,14 @@ void Effect::setup(LedsLayer &leds, Variable parentVar) {
           }
           default: leds.palette = PartyColors_p; //should never occur
         }
+        leds.paletteChanged();
         return true;
       default: return false;
     }});
 }
 
-void PhysMap::addIndexP(LedsLayer &leds, uint16_t indexP) {
+template <typename Word, uint8_t IndexBits>
+void PhysMapT<Word, IndexBits>::addIndexP(LedsLayer &leds, uint16_t indexP) {
   // ppf("addIndexP i:%d t:%d", indexP, mapType);
   switch (mapType) {
     case m_color:
@@ -84,26 +117,23 @@ void PhysMap::addIndexP(LedsLayer &leds, uint16_t indexP) {
       break;
     case m_onePixel: {
       uint16_t oldIndexP = this->indexP;
-      // std::vector<uint16_t> newVector;
-      // newVector.push_back(oldIndexP);
-      // newVector.push_back(indexP);
-      leds.mappingTableIndexesSizeUsed++;
-      if (leds.mappingTableIndexes.size() < leds.mappingTableIndexesSizeUsed)
-        leds.mappingTableIndexes.push_back({oldIndexP, indexP});
-      else
-        leds.mappingTableIndexes[leds.mappingTableIndexesSizeUsed-1] = {oldIndexP, indexP};
-
-      indexes = leds.mappingTableIndexesSizeUsed - 1; //array position
+      indexes = leds.mappingTableIndexesSizeUsed++; //new group
+      leds.mappingTableBuild.push_back((uint32_t)indexes << 16 | oldIndexP);
+      leds.mappingTableBuild.push_back((uint32_t)indexes << 16 | indexP);
       mapType = m_morePixels;
       break; }
     case m_morePixels:
-      leds.mappingTableIndexes[indexes].push_back(indexP);
-      // ppf(" more %d", mappingTableIndexes.size());
+      leds.mappingTableBuild.push_back((uint32_t)indexes << 16 | indexP);
+      // ppf(" more %d", mappingTableBuild.size());
       break;
   }
   // ppf("\n");
 }
 
+//both layouts, PhysMap is one of them
+template struct PhysMapT<uint16_t, 14>;
+template struct PhysMapT<uint32_t, 30>;
+
 void LedsLayer::triggerMapping() {
     doMap = true; //specify which leds to remap
     fix->mappingStatus = 1; //start mapping
@@ -136,25 +166,44 @@ int LedsLayer::XYZ(int x, int y, int z) {
 
 int LedsLayer::XYZ(Coord3D pixel) {
 
-  //using cached virtual class methods! (so no need for if projectionNr optimizations!)
-  if (projection) {
-    projectionData.begin(); //not const
-    (projection->*XYZCached)(*this, pixel); //not const
+  switch (transform.type) {
+    case t_identity:
+      break;
+    case t_matrix:
+      transform.apply(pixel, size);
+      break;
+    default:
+      //using cached virtual class methods! (so no need for if projectionNr optimizations!)
+      if (projection) {
+        projectionData.begin(); //not const
+        (projection->*XYZCached)(*this, pixel); //not const
+      }
   }
 
   return XYZUnprojected(pixel);
 }
 
+//once per frame, before the effect runs: the projection sets what XYZ does in this frame
+void LedsLayer::frameTransform() {
+  if (projection) {
+    projectionData.begin();
+    projection->frameTransform(*this, transform);
+  } else
+    transform.type = t_identity;
+}
+
 // maps the virtual led to the physical led(s) and assign a color to it
 void LedsLayer::setPixelColor(const int indexV, const CRGB& color) {
   if (indexV < 0)
     return;
+  else if (ledsV) { //mapped in compose()
+    if (indexV < ledsVSize)
+      ledsV[indexV] = color;
+  }
   else if (indexV < mappingTableSizeUsed) {
     switch (mappingTable[indexV].mapType) {
       case m_color:{
-        mappingTable[indexV].rgb14 = ((min(color.r + 3, 255) >> 3) << 9) + 
-                                     ((min(color.g + 3, 255) >> 3) << 4) + 
-                                      (min(color.b + 7, 255) >> 4);
+        mappingTable[indexV].setRGB(color);
         break;
       }
       case m_onePixel: {
@@ -166,33 +215,35 @@ void LedsLayer::setPixelColor(const int indexV, const CRGB& color) {
         //   fix->ledsP[indexP].b = color.r;
         // }
         // else
-        fix->ledsP[indexP] = fix->pixelsToBlend[indexP]?blend(color, fix->ledsP[indexP], fix->globalBlend):color;
+        fix->ledsP[indexP] = color;
         break; }
-      case m_morePixels:
-        if (mappingTable[indexV].indexes < mappingTableIndexes.size())
-          for (uint16_t indexP: mappingTableIndexes[mappingTable[indexV].indexes]) {
+      case m_morePixels: {
+        uint16_t group = mappingTable[indexV].indexes;
+        if ((size_t)group + 1 < mappingTableOffsets.size())
+          for (uint16_t i = mappingTableOffsets[group]; i < mappingTableOffsets[group + 1]; i++) {
+            uint16_t indexP = mappingTableIndexes[i];
             // if (indexP > 2800) {
             //   fix->ledsP[indexP].r = color.b;
             //   fix->ledsP[indexP].g = color.g;
             //   fix->ledsP[indexP].b = color.r;
             // } else
-            fix->ledsP[indexP] = fix->pixelsToBlend[indexP]?blend(color, fix->ledsP[indexP], fix->globalBlend): color;
+            fix->ledsP[indexP] = color;
           }
         else
-          ppf("dev setPixelColor i:%d m:%d s:%d\n", indexV, mappingTable[indexV].indexes, mappingTableIndexes.size());
-        break;
+          ppf("dev setPixelColor i:%d m:%d s:%d\n", indexV, group, mappingTableOffsets.size());
+        break; }
       default: ;
     }
   }
-  else if (indexV < STARLIGHT_MAXLEDS) //no projection
-    fix->ledsP[indexV] = fix->pixelsToBlend[indexV]?blend(color, fix->ledsP[indexV], fix->globalBlend): color;
+  else if (indexV < fix->nrOfLeds) //no projection
+    fix->ledsP[indexV] = color;
   // some operations will go out of bounds e.g. VUMeter, uncomment below lines if you wanna test on a specific effect
   // else //if (indexV != UINT16_MAX) //assuming UINT16_MAX is set explicitly (e.g. in XYZ)
   //   ppf(" dev sPC %d >= %d", indexV, STARLIGHT_MAXLEDS);
 }
 
 void LedsLayer::setPixelColorPal(const int indexV, uint8_t palIndex, uint8_t palBri) {
-  setPixelColor(indexV, ColorFromPalette(palette, palIndex, palBri));
+  setPixelColor(indexV, colorFromPalette(palIndex, palBri));
 }
 
 void LedsLayer::blendPixelColor(const int indexV, const CRGB& color, uint8_t blendAmount) {
@@ -202,18 +253,20 @@ void LedsLayer::blendPixelColor(const int indexV, const CRGB& color, uint8_t ble
 CRGB LedsLayer::getPixelColor(const int indexV) const {
   if (indexV < 0)
     return CRGB::Black;
+  else if (ledsV)
+    return indexV < ledsVSize?ledsV[indexV]:CRGB::Black;
   else if (indexV < mappingTableSizeUsed) {
     switch (mappingTable[indexV].mapType) {
       case m_onePixel:
         return fix->ledsP[mappingTable[indexV].indexP]; 
         break;
       case m_morePixels:
-        return fix->ledsP[mappingTableIndexes[mappingTable[indexV].indexes][0]]; //any will do as they are all the same
+        if ((size_t)mappingTable[indexV].indexes + 1 < mappingTableOffsets.size())
+          return fix->ledsP[mappingTableIndexes[mappingTableOffsets[mappingTable[indexV].indexes]]]; //any will do as they are all the same
+        return CRGB::Black;
         break;
       default: // m_color:
-        return CRGB((mappingTable[indexV].rgb14 >> 9) << 3, 
-                    (mappingTable[indexV].rgb14 >> 4) << 3, 
-                     mappingTable[indexV].rgb14       << 4);
+        return mappingTable[indexV].getRGB();
         break;
     }
   }
@@ -226,15 +279,174 @@ CRGB LedsLayer::getPixelColor(const int indexV) const {
   }
 }
 
+uint16_t LedsLayer::spanIndexes(const Coord3D &start, const uint8_t axis, uint16_t length) {
+  if (axis > a_z || !inBounds(start)) return 0;
+  length = min((int)length, axis == a_x?size.x - start.x:axis == a_y?size.y - start.y:size.z - start.z);
+  if (spanIndexesV.size() < length) {
+    spanIndexesV.resize(length);
+    spanColors.resize(length);
+  }
+
+  if (!projection) { //XYZ is a stride
+    const int stride = axis == a_x?1:axis == a_y?size.x:size.x * size.y;
+    int indexV = XYZUnprojected(start);
+    for (uint16_t i = 0; i < length; i++, indexV += stride)
+      spanIndexesV[i] = indexV;
+  } else {
+    Coord3D pixel = start;
+    int &step = axis == a_x?pixel.x:axis == a_y?pixel.y:pixel.z;
+    for (uint16_t i = 0; i < length; i++, step++)
+      spanIndexesV[i] = XYZ(pixel);
+  }
+  return length;
+}
+
+void LedsLayer::readResolved(const uint16_t length, CRGB *colors) const {
+  if (ledsV) {
+    for (uint16_t i = 0; i < length; i++) {
+      const int indexV = spanIndexesV[i];
+      colors[i] = (indexV >= 0 && indexV < ledsVSize)?ledsV[indexV]:CRGB::Black;
+    }
+  } else {
+    for (uint16_t i = 0; i < length; i++)
+      colors[i] = getPixelColor(spanIndexesV[i]);
+  }
+}
+
+void LedsLayer::writeResolved(const uint16_t length, const CRGB *colors) {
+  if (ledsV) {
+    for (uint16_t i = 0; i < length; i++) {
+      const int indexV = spanIndexesV[i];
+      if (indexV >= 0 && indexV < ledsVSize) ledsV[indexV] = colors[i];
+    }
+  } else {
+    for (uint16_t i = 0; i < length; i++)
+      setPixelColor(spanIndexesV[i], colors[i]);
+  }
+}
+
+void LedsLayer::readSpan(const Coord3D &start, const uint8_t axis, const uint16_t length, CRGB *colors) {
+  const uint16_t resolved = spanIndexes(start, axis, length);
+  readResolved(resolved, colors);
+  for (uint16_t i = resolved; i < length; i++) colors[i] = CRGB::Black; //outside the layer
+}
+
+void LedsLayer::writeSpan(const Coord3D &start, const uint8_t axis, const uint16_t length, const CRGB *colors) {
+  writeResolved(spanIndexes(start, axis, length), colors);
+}
+
+void LedsLayer::fillSpan(const Coord3D &start, const uint8_t axis, const uint16_t length, const CRGB &color) {
+  const uint16_t resolved = spanIndexes(start, axis, length);
+  if (ledsV) {
+    for (uint16_t i = 0; i < resolved; i++) {
+      const int indexV = spanIndexesV[i];
+      if (indexV >= 0 && indexV < ledsVSize) ledsV[indexV] = color;
+    }
+  } else {
+    for (uint16_t i = 0; i < resolved; i++)
+      setPixelColor(spanIndexesV[i], color);
+  }
+}
+
+void LedsLayer::blurResolved(const uint16_t length, const fract8 blur_amount) {
+  CRGB *colors = spanColors.data();
+  readResolved(length, colors);
+
+  const uint8_t keep = 255 - blur_amount;
+  const uint8_t seep = blur_amount >> 1;
+  CRGB carryover = CRGB::Black;
+  for (uint16_t i = 0; i < length; i++) {
+    CRGB cur = colors[i];
+    CRGB part = cur;
+    part.nscale8(seep);
+    cur.nscale8(keep);
+    cur += carryover;
+    if (i) colors[i-1] += part;
+    colors[i] = cur;
+    carryover = part;
+  }
+
+  writeResolved(length, colors);
+}
+
+//blend a layer pixel into a physical pixel, 8 bit fixed point, mode is resolved at compile time
+template <uint8_t mode>
+static inline void blendPixel(CRGB &dst, const CRGB &src, const uint8_t opacity) {
+  CRGB top;
+  switch (mode) {
+    case b_add:
+      dst.r = qadd8(dst.r, scale8(src.r, opacity));
+      dst.g = qadd8(dst.g, scale8(src.g, opacity));
+      dst.b = qadd8(dst.b, scale8(src.b, opacity));
+      return;
+    case b_max:
+      dst.r = max(dst.r, scale8(src.r, opacity));
+      dst.g = max(dst.g, scale8(src.g, opacity));
+      dst.b = max(dst.b, scale8(src.b, opacity));
+      return;
+    case b_multiply:
+      top = CRGB(scale8(dst.r, src.r), scale8(dst.g, src.g), scale8(dst.b, src.b));
+      break;
+    case b_screen:
+      top = CRGB(255 - scale8(255 - dst.r, 255 - src.r), 255 - scale8(255 - dst.g, 255 - src.g), 255 - scale8(255 - dst.b, 255 - src.b));
+      break;
+    default: //b_alpha
+      top = src;
+  }
+  if (opacity == 255)
+    dst = top;
+  else
+    nblend(dst, top, opacity);
+}
+
+template <uint8_t mode>
+void LedsLayer::composeMode() {
+  const uint8_t opacity = this->opacity;
+  CRGB *ledsP = fix->ledsP;
+
+  if (!projection) { //indexV == indexP
+    for (uint16_t indexP = 0; indexP < ledsVSize; indexP++)
+      blendPixel<mode>(ledsP[indexP], ledsV[indexP], opacity);
+    return;
+  }
+
+  for (uint16_t indexV = 0; indexV < mappingTableSizeUsed && indexV < ledsVSize; indexV++) {
+    const PhysMap &map = mappingTable[indexV];
+    switch (map.mapType) {
+      case m_onePixel:
+        blendPixel<mode>(ledsP[map.indexP], ledsV[indexV], opacity);
+        break;
+      case m_morePixels:
+        for (uint16_t i = mappingTableOffsets[map.indexes]; i < mappingTableOffsets[map.indexes + 1]; i++)
+          blendPixel<mode>(ledsP[mappingTableIndexes[i]], ledsV[indexV], opacity);
+        break;
+      default: ; //m_color: not mapped to a physical led
+    }
+  }
+}
+
+void LedsLayer::compose() {
+  if (!ledsV) return;
+
+  switch (blendMode) {
+    case b_add:      composeMode<b_add>(); break;
+    case b_max:      composeMode<b_max>(); break;
+    case b_multiply: composeMode<b_multiply>(); break;
+    case b_screen:   composeMode<b_screen>(); break;
+    default:         composeMode<b_alpha>();
+  }
+}
+
 void LedsLayer::fadeToBlackBy(const uint8_t fadeBy) {
   if (effectDimension < projectionDimension) { //only process the effect pixels (so projections can do things with the other dimension)
     for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        CRGB color = getPixelColor({x,y,0});
-        color.nscale8(255-fadeBy);
-        setPixelColor({x,y,0}, color);
-      }
+      const uint16_t resolved = spanIndexes({0,y,0}, a_x, size.x);
+      readResolved(resolved, spanColors.data());
+      fastled_fadeToBlackBy(spanColors.data(), resolved, fadeBy);
+      writeResolved(resolved, spanColors.data());
     }
+  } else if (ledsV) {
+    fastled_fadeToBlackBy(ledsV, ledsVSize, fadeBy);
   } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
     fastled_fadeToBlackBy(fix->ledsP, fix->nrOfLeds, fadeBy);
   } else {
@@ -248,11 +460,10 @@ void LedsLayer::fadeToBlackBy(const uint8_t fadeBy) {
 
 void LedsLayer::fill_solid(const CRGB& color) {
   if (effectDimension < projectionDimension) { //only process the effect pixels (so projections can do things with the other dimension)
-    for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        setPixelColor({x,y,0}, color);
-      }
-    }
+    for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) //1D effects only on y=0, 2D effects loop over y
+      fillSpan({0,y,0}, a_x, size.x, color);
+  } else if (ledsV) {
+    fastled_fill_solid(ledsV, ledsVSize, color);
   } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
     fastled_fill_solid(fix->ledsP, fix->nrOfLeds, color);
   } else {
@@ -263,16 +474,13 @@ void LedsLayer::fill_solid(const CRGB& color) {
 
 void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
   if (effectDimension < projectionDimension) { //only process the effect pixels (so projections can do things with the other dimension)
-    CHSV hsv;
-    hsv.hue = initialhue;
-    hsv.val = 255;
-    hsv.sat = 240;
     for (int y=0; y < ((effectDimension == _1D)?1:size.y); y++) { //1D effects only on y=0, 2D effects loop over y
-      for (int x=0; x<size.x; x++) {
-        setPixelColor({x,y,0}, hsv);
-        hsv.hue += deltahue;
-      }
+      const uint16_t resolved = spanIndexes({0,y,0}, a_x, size.x);
+      fastled_fill_rainbow(spanColors.data(), resolved, initialhue + y * size.x * deltahue, deltahue); //hue continues over the rows
+      writeResolved(resolved, spanColors.data());
     }
+  } else if (ledsV) {
+    fastled_fill_rainbow(ledsV, ledsVSize, initialhue, deltahue);
   } else if (!projection || (fix->layers.size() == 1)) { //faster, else manual 
     fastled_fill_rainbow(fix->ledsP, fix->nrOfLeds, initialhue, deltahue);
   } else {
@@ -329,15 +537,15 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
 
   void LedsLayer::addPixelsPre(const uint8_t rowNr) {
     if (doMap) {
-      fill_solid(CRGB::Black);
+      if (!mapBuilding) fill_solid(CRGB::Black); //building the shadow: the live mapping keeps rendering
 
       ppf("addPixelsPre clear leds[x] effect:%s pro:%s\n", effect?effect->name():"None", projection?projection->name():"None");
       size = Coord3D{0,0,0};
-      //vectors really gone now?
-      for (std::vector<uint16_t> mappingTableIndex: mappingTableIndexes) {
-        mappingTableIndex.clear();
-      }
-      mappingTableIndexesSizeUsed = 0; //do not clear mappingTableIndexes, reuse it
+      //clear keeps the capacity: no heap traffic when remapping to a similar size
+      mappingTableBuild.clear();
+      mappingTableOffsets.clear();
+      mappingTableIndexes.clear();
+      mappingTableIndexesSizeUsed = 0;
 
       for (size_t i = 0; i < mappingTable.size(); i++) {
         mappingTable[i] = PhysMap();
@@ -368,6 +576,16 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
         (projection->*addPixelsPreCached)(*this);
         mdl->getValueRowNr = UINT8_MAX; // end of run projection functions in the right rowNr context
       }
+
+      mappingKey = hashBytes(&size, sizeof(Coord3D));
+      mappingKey = hashBytes(&start, sizeof(Coord3D), mappingKey);
+      mappingKey = hashBytes(&middle, sizeof(Coord3D), mappingKey);
+      mappingKey = hashBytes(&end, sizeof(Coord3D), mappingKey);
+      mappingKey = hashBytes(&effectDimension, sizeof(effectDimension), mappingKey);
+      if (projection) {
+        mappingKey = hashBytes(projection->name(), strlen(projection->name()), mappingKey);
+        mappingKey = projectionData.hash(mappingKey);
+      }
     }
   }
 
@@ -434,6 +652,22 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
           mappingTableSizeUsed++;
         }
 
+        //pack the one to many groups: count per group, running total, then place in reverse so each group keeps the order of addPixel
+        //  (already packed if restored from the mapping cache)
+        if (mappingTableOffsets.empty()) {
+          mappingTableOffsets.assign(mappingTableIndexesSizeUsed + 1, 0);
+          for (uint32_t entry: mappingTableBuild) mappingTableOffsets[entry >> 16]++;
+          for (uint16_t group = 1; group < mappingTableIndexesSizeUsed; group++) mappingTableOffsets[group] += mappingTableOffsets[group - 1];
+          mappingTableOffsets[mappingTableIndexesSizeUsed] = mappingTableBuild.size();
+          mappingTableIndexes.resize(mappingTableBuild.size());
+          for (size_t i = mappingTableBuild.size(); i-- > 0;) {
+            uint32_t entry = mappingTableBuild[i];
+            mappingTableIndexes[--mappingTableOffsets[entry >> 16]] = entry & 0xFFFF;
+          }
+        }
+        mappingTableBuild.clear();
+        mappingTableBuild.shrink_to_fit(); //only needed while mapping
+
         //debug info + summary values
         for (size_t i = 0; i< mappingTableSizeUsed; i++) {
           PhysMap &map = mappingTable[i];
@@ -448,8 +682,8 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
             case m_morePixels:
               // ppf("ledV %d mapping >1: #ledsP :", nrOfLogical);
               
-              for (uint16_t indexP: mappingTableIndexes[map.indexes]) {
-                // ppf(" %d", indexP);
+              for (uint16_t i = mappingTableOffsets[map.indexes]; i < mappingTableOffsets[map.indexes + 1]; i++) {
+                // ppf(" %d", mappingTableIndexes[i]);
                 nrOfPhysicalM++;
               }
               // ppf("\n");
@@ -463,12 +697,41 @@ void LedsLayer::fill_rainbow(const uint8_t initialhue, const uint8_t deltahue) {
 
       ppf("addPixelsPost leds[%d] V:%d x %d x %d (v:%d - p:%d pm:%d of %d c:%d)\n", rowNr, size.x, size.y, size.z, nrOfLogical, nrOfPhysical, nrOfPhysicalM, mappingTableIndexesSizeUsed, nrOfColor);
 
+      //virtual framebuffer: (re)allocate for the new size or free if no longer needed
+      //  needed if chosen, for opacity and if there are more layers to compose
+      uint16_t nrOfVirtual = projection?min(size.x * size.y * size.z, STARLIGHT_MAXLEDS):fix->nrOfLeds;
+      if ((virtualBuffer || opacity < 255 || fix->layers.size() > 1) && nrOfVirtual) {
+        if (ledsVSize != nrOfVirtual) {
+          size_t bytes = nrOfVirtual * sizeof(CRGB);
+          CRGB *newLedsV = (CRGB *)(psramFound()?ps_realloc(ledsV, bytes):realloc(ledsV, bytes)); // use PSRAM if it exists
+          if (newLedsV) {
+            ledsV = newLedsV;
+            ledsVSize = nrOfVirtual;
+          } else {
+            ppf("dev addPixelsPost leds[%d] virtual buffer of %d B not allocated, drawing direct\n", rowNr, bytes);
+            free(ledsV);
+            ledsV = nullptr;
+            ledsVSize = 0;
+          }
+        }
+        if (ledsV) fastled_fill_solid(ledsV, ledsVSize, CRGB::Black);
+      } else if (ledsV) {
+        free(ledsV);
+        ledsV = nullptr;
+        ledsVSize = 0;
+      }
+
       StarString buf;
       buf.format("%d x %d x %d", size.x, size.y, size.z);
       mdl->setValue("layers", "size", JsonString(buf.getString()), rowNr);
 
-      ppf("addPixelsPost leds[%d].size = so:%d + m:(%d of %d) * %d + d:(%d + %d) B\n", rowNr, sizeof(LedsLayer), mappingTableSizeUsed, mappingTable.size(), sizeof(PhysMap), effectData.bytesAllocated, projectionData.bytesAllocated); //44 -> 164
+      buf.format("%d B", mappingBytes());
+      mdl->setValue("layers", "mapping", JsonString(buf.getString()), rowNr);
+
+      ppf("addPixelsPost leds[%d].size = so:%d + m:(%d of %d) * %d + i:(%d + %d) * 2 + v:%d * 3 + d:(%d + %d) B\n", rowNr, sizeof(LedsLayer), mappingTableSizeUsed, mappingTable.size(), sizeof(PhysMap), mappingTableIndexes.size(), mappingTableOffsets.size(), ledsVSize, effectData.bytesAllocated, projectionData.bytesAllocated); //44 -> 164
 
+      mapped = true;
+      mappedProjection = projection;
       doMap = false;
     } //doMap
 
@@ -19,6 +19,9 @@
 // #define I2S_DEVICE 1                  // I2S driver: allows to still use I2S#0 for audio (only on esp32 and esp32-s3)
 // #define FASTLED_I2S_MAX_CONTROLLERS 8 // 8 LED pins should be enough (default = 24)
 
+#include <new> //placement new of the effect controls
+#include <type_traits>
+
 #include "FastLED.h" //CRGB
 
 #include "../Sys/SysModModel.h" //for Coord3D
@@ -27,8 +30,16 @@
   #define STARLIGHT_MAXLEDS 8192 //any board can do this
 #endif
 
+#define effectControlsBytes 32 //max size of the typed controls of an effect, see LedsLayer::initControls
+
 class LedsLayer; //forward
 
+//FNV-1a, chain calls by passing the previous hash
+inline uint32_t hashBytes(const void *bytes, size_t length, uint32_t hash = 2166136261u) {
+  for (size_t i = 0; i < length; i++) hash = (hash ^ ((const uint8_t *)bytes)[i]) * 16777619u;
+  return hash;
+}
+
 #define _1D 1
 #define _2D 2
 #define _3D 3
@@ -42,11 +53,84 @@ public:
   virtual const char * tags() {return "";}
   virtual uint8_t dim() {return _1D;};
 
+  //bytes of effectData used by the controls and the state (not the large arrays), 0: found by a dry run of loop
+  virtual size_t dataSize(const LedsLayer &leds) {return 0;}
+
   virtual void setup(LedsLayer &leds, Variable parentVar);
 
   virtual void loop(LedsLayer &leds) {}
 };
 
+//what a projection does to each virtual pixel in a frame: set once per frame by Projection::frameTransform, applied by XYZ
+enum transformType {
+  t_identity, //pixels unchanged
+  t_matrix,   //integer matrix and offsets below
+  t_perPixel  //Projection::XYZ is called for each pixel
+};
+
+enum transformBounds {
+  tb_none, //out of bounds pixels stay out of bounds
+  tb_wrap,
+  tb_clamp
+};
+
+#define transformShift 10 //fixed point matrix, 1 << transformShift is 1.0
+
+//sin and cos without float: angle 0..65535 is one period, result is Q15 (-32767..32767)
+//  table of a quarter period (1024 steps per period) with linear interpolation, error is 1 lsb at most
+int16_t sinQ15(uint16_t angle);
+inline int16_t cosQ15(uint16_t angle) {return sinQ15(angle + 16384);}
+
+struct PixelTransform {
+  uint8_t type = t_perPixel;
+  int32_t m[3][3]; //rows x, y, z
+  Coord3D pre;  //subtracted before the matrix (center of rotation)
+  Coord3D post; //added after the matrix (center of rotation + offset)
+  uint8_t bounds[3]; //transformBounds per axis
+
+  void identity() {
+    type = t_matrix;
+    for (uint8_t row = 0; row < 3; row++)
+      for (uint8_t col = 0; col < 3; col++)
+        m[row][col] = row == col ? 1 << transformShift : 0;
+    pre = {0,0,0};
+    post = {0,0,0};
+    bounds[0] = bounds[1] = bounds[2] = tb_none;
+  }
+
+  //rotate after the current transform, axis 0: tilt (around x), 1: pan (around y), 2: roll (around z), as Trigo
+  void rotate(uint8_t axis, uint16_t angle, uint16_t period = 360) {
+    uint16_t phase = period ? (uint32_t)(angle % period) * 65536 / period : 0;
+    constexpr int shift = 15 - transformShift; //Q15 to the matrix
+    int32_t c = (cosQ15(phase) + (1 << (shift - 1))) >> shift;
+    int32_t s = (sinQ15(phase) + (1 << (shift - 1))) >> shift;
+    uint8_t a = axis == 0 ? 1 : 0; //the two rows which change
+    uint8_t b = axis == 2 ? 1 : 2;
+    if (axis == 1) s = -s; //pan: x' = cos x + sin z
+    for (uint8_t col = 0; col < 3; col++) {
+      int32_t ma = m[a][col], mb = m[b][col];
+      m[a][col] = (c * ma - s * mb) >> transformShift;
+      m[b][col] = (s * ma + c * mb) >> transformShift;
+    }
+  }
+
+  static int bound(int value, int size, uint8_t bounds) {
+    switch (bounds) {
+      case tb_wrap: value %= size; return value < 0 ? value + size : value;
+      case tb_clamp: return value < 0 ? 0 : value >= size ? size - 1 : value;
+      default: return value;
+    }
+  }
+
+  void apply(Coord3D &pixel, const Coord3D &size) const {
+    const int dx = pixel.x - pre.x, dy = pixel.y - pre.y, dz = pixel.z - pre.z;
+    constexpr int half = 1 << (transformShift - 1); //round to nearest
+    pixel.x = bound(((m[0][0] * dx + m[0][1] * dy + m[0][2] * dz + half) >> transformShift) + post.x, size.x, bounds[0]);
+    pixel.y = bound(((m[1][0] * dx + m[1][1] * dy + m[1][2] * dz + half) >> transformShift) + post.y, size.y, bounds[1]);
+    pixel.z = bound(((m[2][0] * dx + m[2][1] * dy + m[2][2] * dz + half) >> transformShift) + post.z, size.z, bounds[2]);
+  }
+};
+
 class Projection {
 public:
   virtual ~Projection() = default;
@@ -65,6 +149,10 @@ public:
   //setupPixel
   virtual void addPixel(LedsLayer &leds, Coord3D &pixel) {} //not const as pixel is changed
 
+  //per frame, before the effect: what XYZ does to each pixel in this frame
+  //  a projection which overrides XYZ sets t_perPixel, if it can be expressed as a matrix, override this instead of XYZ
+  virtual void frameTransform(LedsLayer &leds, PixelTransform &transform) {transform.type = t_identity;}
+
   //loopPixel
   virtual void XYZ(LedsLayer &leds, Coord3D &pixel) {}
 };
@@ -76,36 +164,133 @@ enum mapType {
   m_count //keep as last entry
 };
 
-struct PhysMap {
+//how a layer is composed on top of the layers below
+enum blendMode {
+  b_alpha,
+  b_add,
+  b_max,
+  b_multiply,
+  b_screen,
+  b_count //keep as last entry
+};
+
+//direction of a span (run of pixels) in virtual coordinates
+enum spanAxis {
+  a_x,
+  a_y,
+  a_z
+};
+
+//one virtual pixel: a color (no physical pixel), one physical pixel or a group of physical pixels
+//  IndexBits: max physical pixels (2^IndexBits), the color uses the same bits
+template <typename Word, uint8_t IndexBits>
+struct PhysMapT {
   union {
     struct {                 //condensed rgb
-      uint16_t rgb14: 14;    //14 bits (554 RGB)
-      byte mapType:2;        //2 bits (4)
-    }; //16 bits
-    uint16_t indexP: 14;   //16384 one physical pixel (type==1) index to ledsP array
-    uint16_t indexes:14;  //16384 multiple physical pixels (type==2) index in std::vector<std::vector<uint16_t>> mappingTableIndexes;
-  }; // 2 bytes
-
-  PhysMap() {
+      Word rgb: IndexBits;   //554 RGB (14 bits) or 888 RGB (24 bits and more)
+      Word mapType:2;        //2 bits (4)
+    };
+    Word indexP: IndexBits;  //one physical pixel (type==1) index to ledsP array
+    Word indexes: IndexBits; //multiple physical pixels (type==2) group in mappingTableOffsets / mappingTableIndexes
+  };
+
+  PhysMapT() {
     mapType = m_color; // the default until indexP is added
-    rgb14 = 0;
+    rgb = 0;
+  }
+
+  void setRGB(const CRGB &color) {
+    if (IndexBits >= 24)
+      rgb = (color.r << 16) + (color.g << 8) + color.b;
+    else
+      rgb = ((min(color.r + 3, 255) >> 3) << 9) + 
+            ((min(color.g + 3, 255) >> 3) << 4) + 
+             (min(color.b + 7, 255) >> 4);
+  }
+
+  CRGB getRGB() const {
+    if (IndexBits >= 24)
+      return CRGB(rgb >> 16, rgb >> 8, rgb);
+    else
+      return CRGB((rgb >> 9) << 3, 
+                  (rgb >> 4) << 3, 
+                   rgb       << 4);
   }
 
   void addIndexP(LedsLayer &leds, uint16_t indexP);
 
-}; // 2 bytes
+};
+
+//compact: 2 bytes, max 16384 physical pixels (default), wide: 4 bytes, 24 bits colors
+#if STARLIGHT_MAXLEDS > 16384 && !defined(STARLIGHT_PHYSMAP_WIDE)
+  #define STARLIGHT_PHYSMAP_WIDE
+#endif
+#ifdef STARLIGHT_PHYSMAP_WIDE
+  typedef PhysMapT<uint32_t, 30> PhysMap; // 4 bytes
+#else
+  typedef PhysMapT<uint16_t, 14> PhysMap; // 2 bytes
+#endif
+static_assert(sizeof(PhysMapT<uint16_t, 14>) == 2 && sizeof(PhysMapT<uint32_t, 30>) == 4, "PhysMap layout");
+static_assert(STARLIGHT_MAXLEDS <= UINT16_MAX, "STARLIGHT_MAXLEDS: physical pixels are indexed by uint16_t");
 
 //StarLight implementation of segment.data
+//  arena walked in the same order each frame (setup writes the controls, loop reads them and its state)
+//  each slot is aligned to its type, the arena grows by adding chunks so slots never move (the ui keeps pointers to the controls)
+//  large arrays (sharedDataBlockBytes or more, e.g. maps or cell grids) get their own block, in PSRAM if it exists,
+//  so the small hot state stays in internal RAM
+#define sharedDataChunkBytes 32
+#define sharedDataBlockBytes 1024
+
 class SharedData {
 
   private:
-    byte *data = nullptr;
-    uint16_t index = 0;
+    struct Chunk {
+      byte *data;
+      size_t bytes;
+    };
+    std::vector<Chunk> chunks; //small slots, in walk order
+    std::vector<Chunk> blocks; //large arrays, in walk order
+    uint8_t chunkIndex = 0;
+    uint16_t index = 0; //in the current chunk
+    uint8_t blockIndex = 0;
     bool dataAllocated = true;
 
+    //a new chunk for at least bytes, 0 initialized
+    bool addChunk(size_t bytes) {
+      bytes = (bytes + sharedDataChunkBytes - 1) / sharedDataChunkBytes * sharedDataChunkBytes;
+      byte *data = (byte *)calloc(1, bytes);
+      if (data == nullptr) {
+        ppf("dev sharedData chunk, alloc not successful %d\n", bytes);
+        dataAllocated = false;
+        return false;
+      }
+      chunks.push_back({data, bytes});
+      bytesAllocated += bytes;
+      return true;
+    }
+
+    //the next large array, (re)allocated if its size changed, contents kept
+    byte *block(size_t bytes) {
+      if (blockIndex == blocks.size()) blocks.push_back({nullptr, 0});
+      Chunk &block = blocks[blockIndex++];
+      if (block.bytes != bytes) {
+        byte *newData = (byte *)(psramFound()?ps_realloc(block.data, bytes):realloc(block.data, bytes)); // use PSRAM if it exists
+        if (newData == nullptr) {
+          ppf("dev sharedData block, alloc not successful %d->%d\n", block.bytes, bytes);
+          dataAllocated = false;
+          return nullptr;
+        }
+        if (bytes > block.bytes) memset(newData + block.bytes, 0, bytes - block.bytes);
+        blockBytes += bytes - block.bytes;
+        block.data = newData;
+        block.bytes = bytes;
+      }
+      return block.data;
+    }
+
   public:
-    uint16_t bytesAllocated = 0;
-    bool alertIfChanged = false;
+    uint16_t bytesAllocated = 0; //chunks
+    size_t blockBytes = 0; //large arrays
 
   SharedData() {
     ppf("SharedData constructor %d %d\n", index, bytesAllocated);
@@ -116,48 +301,52 @@ class SharedData {
   }
 
   void clear() {
-    ppf("SharedData clearing data %d %d %p\n", index, bytesAllocated, data);
-    if (data) {
-      free(data);
-      data = nullptr;
-    }
+    ppf("SharedData clearing data %d %d\n", chunks.size(), bytesAllocated);
+    for (Chunk &chunk: chunks) free(chunk.data);
+    chunks.clear();
+    for (Chunk &block: blocks) free(block.data);
+    blocks.clear();
     bytesAllocated = 0;
-    alertIfChanged = false;
+    blockBytes = 0;
     dataAllocated = true;
     begin();
   }
 
+  //pre-size the first chunk, e.g. to the declared dataSize of an effect, so its state is in one piece of memory
+  void reserve(size_t bytes) {
+    if (bytes && chunks.empty()) addChunk(bytes);
+  }
+
   //sets the effectData pointer back to 0 so loop effect can go through it
   void begin() {
+    chunkIndex = 0;
     index = 0;
+    blockIndex = 0;
   }
 
+  //bytes of a walk of these types (arrays as Type[length]), with alignment, e.g. for Effect::dataSize
+  template <typename Type>
+  static constexpr size_t aligned(size_t index) {return (index + alignof(Type) - 1) & ~(alignof(Type) - 1);}
+  template <typename Type>
+  static constexpr size_t sizeOf(size_t index = 0) {return aligned<Type>(index) + sizeof(Type);}
+  template <typename Type, typename Next, typename... Rest>
+  static constexpr size_t sizeOf(size_t index = 0) {return sizeOf<Next, Rest...>(aligned<Type>(index) + sizeof(Type));}
+
   //returns the next pointer to a specified type (length for arrays)
   template <typename Type>
   Type * readWrite(int length = 1) {
     if (!dataAllocated) return nullptr;
-    size_t newIndex = index + length * sizeof(Type);
-    if (newIndex > bytesAllocated) { //newIndex is index for next allocation
-      size_t newSize = bytesAllocated + (1 + ( newIndex - bytesAllocated)/32) * 32; // add a multitude of 32 bytes
-      ppf("sharedData.readWrite add more %d->%d %d->%d\n", index, newIndex, bytesAllocated, newSize);
-      if (bytesAllocated == 0)
-        data = (byte*) malloc(newSize);
-      else
-        data = (byte*)reallocf(data, newSize);
-      if (data != nullptr) { //only if alloc is successful
-        memset(data, 0, newSize); //init data with 0
-        if (alertIfChanged)
-          ppf("dev sharedData.readWrite reallocating, this should not happen ! %d -> %d\n", bytesAllocated, newSize);
-        bytesAllocated = newSize;
-      }
-      else {
-        ppf("dev sharedData.readWrite, alloc not successful %d->%d %d->%d\n", index, newIndex, bytesAllocated, newSize);
-        dataAllocated = false;
-      }
+    size_t bytes = length * sizeof(Type);
+    if (bytes >= sharedDataBlockBytes) return reinterpret_cast<Type *>(block(bytes));
+    size_t slot = aligned<Type>(index);
+    while (chunkIndex >= chunks.size() || slot + bytes > chunks[chunkIndex].bytes) { //does not fit: next chunk
+      if (chunkIndex < chunks.size()) chunkIndex++;
+      if (chunkIndex == chunks.size() && !addChunk(bytes)) return nullptr;
+      slot = 0;
     }
     // ppf("bind %d->%d %d\n", index, newIndex, bytesAllocated);
-    Type * returnValue  = reinterpret_cast<Type *>(data + index);
-    index = newIndex; //add consumed amount of bytes, index is next byte which will be pointed to
+    Type * returnValue  = reinterpret_cast<Type *>(chunks[chunkIndex].data + slot);
+    index = slot + bytes; //add consumed amount of bytes, index is next byte which will be pointed to
     return returnValue;
   }
 
@@ -180,6 +369,12 @@ class SharedData {
     return dataAllocated;
   }
 
+  uint32_t hash(uint32_t hash) const {
+    for (const Chunk &chunk: chunks) hash = hashBytes(chunk.data, chunk.bytes, hash);
+    for (const Chunk &block: blocks) hash = hashBytes(block.data, block.bytes, hash);
+    return hash;
+  }
+
 };
 
 class LedsLayer {
@@ -199,6 +394,9 @@ public:
   void (Projection::*XYZCached)(LedsLayer &, Coord3D &) = &Projection::XYZ;
   void (Projection::*loopCached)(LedsLayer &) = &Projection::loop;
 
+  PixelTransform transform; //of the projection in this frame
+  void frameTransform();
+
   uint8_t effectDimension = UINT8_MAX;
   uint8_t projectionDimension = UINT8_MAX;
 
@@ -214,14 +412,81 @@ public:
   SharedData effectData;
   SharedData projectionData;
 
+  //typed controls of the effect: a plain struct with default member values, held here so no allocation and no walk
+  //  setup: Controls &controls = leds.initControls<Controls>(); ui->initSlider(parentVar, "speed", &controls.speed);
+  //  loop:  const Controls &controls = leds.controls<Controls>();
+  alignas(8) byte controlsData[effectControlsBytes] = {0};
+
+  template <typename Controls>
+  Controls &initControls() {
+    static_assert(sizeof(Controls) <= effectControlsBytes, "effect controls do not fit in effectControlsBytes");
+    static_assert(alignof(Controls) <= 8 && std::is_trivially_destructible<Controls>::value, "effect controls must be a plain struct");
+    return *new (controlsData) Controls(); //default values
+  }
+
+  template <typename Controls>
+  Controls &controls() {
+    static_assert(sizeof(Controls) <= effectControlsBytes, "effect controls do not fit in effectControlsBytes");
+    return *reinterpret_cast<Controls *>(controlsData);
+  }
+
   std::vector<PhysMap> mappingTable;
   uint16_t mappingTableSizeUsed = 0;
-  std::vector<std::vector<uint16_t>> mappingTableIndexes;
-  uint16_t mappingTableIndexesSizeUsed = 0;
+  //one virtual pixel to many physical pixels (m_morePixels), all groups in one array (CSR):
+  //  group g = mappingTableIndexes[mappingTableOffsets[g]] .. mappingTableIndexes[mappingTableOffsets[g+1] - 1]
+  std::vector<uint16_t> mappingTableIndexes;
+  std::vector<uint16_t> mappingTableOffsets; //mappingTableIndexesSizeUsed + 1 entries after addPixelsPost
+  uint16_t mappingTableIndexesSizeUsed = 0; //nr of groups
+  std::vector<uint32_t> mappingTableBuild; //group << 16 | indexP, collected by addIndexP during mapping, packed into the above in addPixelsPost
   
   bool doMap = true; //so a mapping will be made
-
-  CRGBPalette16 palette;
+  bool doInitEffect = false; //initEffect after mapping (effect dimension changed)
+
+  //double buffered mapping: a remap with the same projection is built in slices into the shadow (LedModFixture::mapSlice)
+  //  while the live mapping keeps rendering, swapMapping exchanges them (only vector pointers, no copies)
+  bool mapped = false; //live mapping complete
+  Projection *mappedProjection = nullptr; //projection the live mapping was made with
+  bool mapBuilding = false; //shadow is being built
+  uint32_t mappingKey = 0; //what the mapping depends on besides the fixture, set in addPixelsPre (LedModFixture::mapCacheLoad)
+  struct {
+    Coord3D size = {8,8,1}, start = {0,0,0}, middle = {0,0,0}, end = {0,0,0};
+    uint8_t projectionDimension = UINT8_MAX;
+    std::vector<PhysMap> mappingTable;
+    uint16_t mappingTableSizeUsed = 0;
+    std::vector<uint16_t> mappingTableIndexes;
+    std::vector<uint16_t> mappingTableOffsets;
+    uint16_t mappingTableIndexesSizeUsed = 0;
+    std::vector<uint32_t> mappingTableBuild;
+  } shadow;
+
+  //virtual framebuffer: effects read and write full colors in virtual coordinates, compose() blends them into fix->ledsP once per frame
+  bool virtualBuffer = false; //chosen per layer, (de)allocated in addPixelsPost (also used for opacity and multiple layers)
+  CRGB *ledsV = nullptr;
+  uint16_t ledsVSize = 0;
+
+  uint8_t opacity = 255;
+  uint8_t blendMode = b_alpha;
+
+  //scratch for spans, grows to the longest span used (max of size.x, y, z)
+  std::vector<int> spanIndexesV;
+  std::vector<CRGB> spanColors;
+
+  CRGBPalette16 palette; //call paletteChanged() after changing it
+  CRGB paletteLUT[256]; //palette expanded with linear blending: a palette color is one load instead of a ColorFromPalette per pixel
+
+  void paletteChanged() {
+    for (int index = 0; index < 256; index++) paletteLUT[index] = ColorFromPalette(palette, index);
+  }
+
+  //same result as ColorFromPalette(palette, index, brightness) (LINEARBLEND)
+  CRGB colorFromPalette(uint8_t index, uint8_t brightness = 255) const {
+    CRGB color = paletteLUT[index];
+    if (brightness != 255) {
+      if (brightness) nscale8x3(color.r, color.g, color.b, brightness + 1); //+1 as ColorFromPalette, adjust for rounding
+      else color = CRGB::Black;
+    }
+    return color;
+  }
 
   #ifdef STARBASE_USERMOD_LIVE
     uint8_t liveEffectID = UINT8_MAX;
@@ -243,87 +508,77 @@ public:
 
   LedsLayer() {
     ppf("LedsLayer constructor (PhysMap:%d)\n", sizeof(PhysMap));
+    paletteChanged();
   }
 
   ~LedsLayer() {
     ppf("LedsLayer destructor\n");
+    if (ledsV) free(ledsV);
+    ledsV = nullptr; //so fadeToBlackBy clears the physical leds
+    ledsVSize = 0;
     fadeToBlackBy();
     doMap = true; // so loop is not running while deleting
-    for (std::vector<uint16_t> mappingTableIndex: mappingTableIndexes) {
-      mappingTableIndex.clear();
-    }
+    mappingTableBuild.clear();
+    mappingTableOffsets.clear();
     mappingTableIndexes.clear();
     mappingTable.clear();
   }
 
   void triggerMapping();
 
-  //set in operator[], used by other operators
-  uint16_t operatorIndexV = 0;
-  CRGB operatorCRGB;
-
-  //leds = leds[indexV] ,[] needs to return LedsLayer to allow other operators to work on it
-  LedsLayer& operator[](const uint16_t indexV) {
-    operatorIndexV = indexV;
-    operatorCRGB = getPixelColor(operatorIndexV); 
-    return *this;
-  }
-
-  //leds = leds[pos]
-  LedsLayer& operator[](const Coord3D &pos) {
-    operatorIndexV = XYZ(pos.x, pos.y, pos.z);
-    operatorCRGB = getPixelColor(operatorIndexV);
-    return *this;
-  }
-
-  //leds = color
-  LedsLayer& operator=(const CRGB &color) {
-    setPixelColor(operatorIndexV, color);
-    return *this;
-  }
-
-  //leds = leds += color
-  LedsLayer& operator+=(const CRGB &color) {
-    setPixelColor(operatorIndexV, operatorCRGB + color);
-    return *this;
-  }
-
-  //leds = leds != color
-  LedsLayer& operator|=(const CRGB &color) {
-    // setPixelColor(operatorIndexV, color);
-    setPixelColor(operatorIndexV, operatorCRGB | color);
-    return *this;
-  }
-
-  //leds = leds + color
-  LedsLayer& operator+(const CRGB &color) {
-    setPixelColor(operatorIndexV, operatorCRGB + color);
-    return *this;
-  }
-
-  //CRGB = leds[].color - color
-  CRGB& operator-(const CRGB &color) {
-    // setPixelColor(operatorIndexV, getPixelColor(operatorIndexV) + color);
-    operatorCRGB -= color;
-    return operatorCRGB;
-  }
-
-  //CRGB = leds[] = leds[]
-  // CRGB& operator=(LedsLayer& leds) {
-  //   return operatorCRGB;
-  // }
-
-
-  //bool = leds != color
-  bool operator!=(const CRGB &color) const {
-    return operatorCRGB != color;
-  }
-
-  //bool = leds[]<crgb
-  bool operator<(const CRGB &color) const {
-    return operatorCRGB < color;
-  }
+  void swapMapping() {
+    std::swap(size, shadow.size);
+    std::swap(start, shadow.start);
+    std::swap(middle, shadow.middle);
+    std::swap(end, shadow.end);
+    std::swap(projectionDimension, shadow.projectionDimension);
+    mappingTable.swap(shadow.mappingTable);
+    std::swap(mappingTableSizeUsed, shadow.mappingTableSizeUsed);
+    mappingTableIndexes.swap(shadow.mappingTableIndexes);
+    mappingTableOffsets.swap(shadow.mappingTableOffsets);
+    std::swap(mappingTableIndexesSizeUsed, shadow.mappingTableIndexesSizeUsed);
+    mappingTableBuild.swap(shadow.mappingTableBuild);
+  }
+
+  //the live mapping can be rendered while remapping: made with the current projection and the effect is initialized
+  bool mappingUsable() const {
+    return mapped && mappedProjection == projection && !doInitEffect;
+  }
+
+  //blend the virtual framebuffer into ledsP using blendMode and opacity (no-op if the layer has none)
+  void compose();
+  template <uint8_t mode> void composeMode();
+
+  //bytes allocated for the mapping of this layer
+  size_t mappingBytes() const {
+    return (mappingTable.capacity() + shadow.mappingTable.capacity()) * sizeof(PhysMap)
+      + (mappingTableIndexes.capacity() + mappingTableOffsets.capacity() + shadow.mappingTableIndexes.capacity() + shadow.mappingTableOffsets.capacity()) * sizeof(uint16_t)
+      + (mappingTableBuild.capacity() + shadow.mappingTableBuild.capacity()) * sizeof(uint32_t);
+  }
+
+  //leds[indexV] or leds[pos]: reference to one virtual pixel, the index is resolved once and the color is only read when needed
+  //  leds[pos] = color writes without reading, leds[pos] += color reads and writes the same index
+  struct PixelRef {
+    LedsLayer &leds;
+    const int indexV;
+
+    operator CRGB() const {return leds.getPixelColor(indexV);}
+
+    PixelRef &operator=(const CRGB &color) {leds.setPixelColor(indexV, color); return *this;}
+    PixelRef &operator=(const PixelRef &other) {leds.setPixelColor(indexV, CRGB(other)); return *this;} //copies the color, not the reference
+    PixelRef &operator+=(const CRGB &color) {leds.setPixelColor(indexV, CRGB(*this) + color); return *this;}
+    PixelRef &operator|=(const CRGB &color) {leds.setPixelColor(indexV, CRGB(*this) | color); return *this;}
+    PixelRef &nscale8(uint8_t scale) {leds.setPixelColor(indexV, CRGB(*this).nscale8(scale)); return *this;}
+    PixelRef &fadeToBlackBy(uint8_t fadeBy) {leds.setPixelColor(indexV, CRGB(*this).fadeToBlackBy(fadeBy)); return *this;}
+
+    CRGB operator+(const CRGB &color) const {return CRGB(*this) + color;}
+    CRGB operator-(const CRGB &color) const {return CRGB(*this) - color;}
+    bool operator!=(const CRGB &color) const {return CRGB(*this) != color;}
+    bool operator<(const CRGB &color) const {return CRGB(*this) < color;}
+  };
 
+  PixelRef operator[](const int indexV) {return {*this, indexV};}
+  PixelRef operator[](const Coord3D &pos) {return {*this, XYZ(pos.x, pos.y, pos.z)};}
 
   // maps the virtual led to the physical led(s) and assign a color to it
   void setPixelColor(int indexV, const CRGB& color);
@@ -348,6 +603,19 @@ public:
   void addPixelColor(int x, int y, int z, const CRGB &color) {setPixelColor(XYZ(x, y, z), getPixelColor(XYZ(x, y, z)) + color);}
   void addPixelColor(const Coord3D &pixel, const CRGB &color) {setPixelColor(pixel, getPixelColor(pixel) + color);}
 
+  //spans: a run of pixels from start along an axis, clipped to the layer (start must be inside)
+  //  XYZ and the projection are resolved once per pixel for the whole run, then the colors are read or written in one go
+  uint16_t spanIndexes(const Coord3D &start, uint8_t axis, uint16_t length); //resolves into spanIndexesV, returns the clipped length
+  void readSpan(const Coord3D &start, uint8_t axis, uint16_t length, CRGB *colors);
+  void writeSpan(const Coord3D &start, uint8_t axis, uint16_t length, const CRGB *colors);
+  void fillSpan(const Coord3D &start, uint8_t axis, uint16_t length, const CRGB &color);
+  //read and write the span last resolved by spanIndexes
+  void readResolved(uint16_t length, CRGB *colors) const;
+  void writeResolved(uint16_t length, const CRGB *colors);
+  //blur1d of a span: each pixel seeps blur_amount/2 into both neighbours
+  void blurSpan(const Coord3D &start, uint8_t axis, uint16_t length, fract8 blur_amount) {blurResolved(spanIndexes(start, axis, length), blur_amount);}
+  void blurResolved(uint16_t length, fract8 blur_amount);
+
   void fadeToBlackBy(uint8_t fadeBy = 255);
   void fill_solid(const CRGB& color);
   void fill_rainbow(uint8_t initialhue, uint8_t deltahue);
@@ -359,19 +627,13 @@ public:
 
   void blur1d(fract8 blur_amount)
   {
-    const uint8_t keep = 255 - blur_amount;
-    const uint8_t seep = blur_amount >> 1;
-    CRGB carryover = CRGB::Black;
-    for( uint16_t i = 0; i < size.x; ++i) {
-        CRGB cur = getPixelColor(i);
-        CRGB part = cur;
-        part.nscale8( seep);
-        cur.nscale8( keep);
-        cur += carryover;
-        if( i) addPixelColor(i-1, part);
-        setPixelColor(i, cur);
-        carryover = part;
+    //1D effects use indexV as position (no XYZ)
+    if (spanIndexesV.size() < (size_t)size.x) {
+      spanIndexesV.resize(size.x);
+      spanColors.resize(size.x);
     }
+    for (int i = 0; i < size.x; i++) spanIndexesV[i] = i;
+    blurResolved(size.x, blur_amount);
   }
 
   void blur2d(fract8 blur_amount)
@@ -380,50 +642,18 @@ public:
       blurColumns(size.x, size.y, blur_amount);
   }
 
+  // blurRows: perform a blur1d on each row of a rectangular matrix
   void blurRows(uint16_t width, uint16_t height, fract8 blur_amount)
   {
-  /*    for (uint16_t row = 0; row < height; row++) {
-          CRGB* rowbase = leds + (row * width);
-          blur1d( rowbase, width, blur_amount);
-      }
-  */
-      // blur rows same as columns, for irregular matrix
-      uint8_t keep = 255 - blur_amount;
-      uint8_t seep = blur_amount >> 1;
-      for (uint16_t row = 0; row < height; row++) {
-          CRGB carryover = CRGB::Black;
-          for (uint16_t i = 0; i < width; i++) {
-              CRGB cur = getPixelColor(i, row, 0);
-              CRGB part = cur;
-              part.nscale8( seep);
-              cur.nscale8( keep);
-              cur += carryover;
-              if( i) addPixelColor(i-1, row, 0, part);
-              setPixelColor(i, row, 0, cur);
-              carryover = part;
-          }
-      }
+      for (int row = 0; row < min((int)height, size.y); row++)
+          blurSpan({0,row,0}, a_x, width, blur_amount);
   }
 
   // blurColumns: perform a blur1d on each column of a rectangular matrix
   void blurColumns(uint16_t width, uint16_t height, fract8 blur_amount)
   {
-      // blur columns
-      uint8_t keep = 255 - blur_amount;
-      uint8_t seep = blur_amount >> 1;
-      for (uint16_t col = 0; col < width; ++col) {
-          CRGB carryover = CRGB::Black;
-          for (uint16_t i = 0; i < height; ++i) {
-              CRGB cur = getPixelColor(col, i, 0);
-              CRGB part = cur;
-              part.nscale8( seep);
-              cur.nscale8( keep);
-              cur += carryover;
-              if( i) addPixelColor(col, i-1, 0, part);
-              setPixelColor(col, i, 0, cur);
-              carryover = part;
-          }
-      }
+      for (int col = 0; col < min((int)width, size.x); col++)
+          blurSpan({col,0,0}, a_y, height, blur_amount);
   }
 
   void drawLine3D(Coord3D a, Coord3D b, CRGB color, bool soft = false, uint8_t depth = UINT8_MAX) {
@@ -450,6 +680,13 @@ public:
 
     //to do implement soft
 
+    //along an axis and inside the layer: one span
+    if (inBounds(x1, y1, z1) && inBounds(x2, y2, z2)) {
+      if (y1 == y2 && z1 == z2) {fillSpan({min(x1, x2), y1, z1}, a_x, abs(x2 - x1) + 1, color); return;}
+      if (x1 == x2 && z1 == z2) {fillSpan({x1, min(y1, y2), z1}, a_y, abs(y2 - y1) + 1, color); return;}
+      if (x1 == x2 && y1 == y2) {fillSpan({x1, y1, min(z1, z2)}, a_z, abs(z2 - z1) + 1, color); return;}
+    }
+
     //Bresenham
     setPixelColor(x1, y1, z1, color);
     int dx = abs(x2 - x1);
@@ -587,6 +824,12 @@ public:
         intersectY += gradient;
         if (steep) std::swap(x,y);  // restore if steep
       }
+    } else if ((dx == 0 || dy == 0) && inBounds(x0, y0) && inBounds(x1, y1)) {
+      // horizontal or vertical: one span
+      if (dy == 0)
+        fillSpan({min(x0, x1), y0, 0}, a_x, dx + 1, color);
+      else
+        fillSpan({x0, min(y0, y1), 0}, a_y, dy + 1, color);
     } else {
       // Bresenham's algorithm
       int err = (dx>dy ? dx : -dy)/2;   // error direction
@@ -678,48 +921,38 @@ public:
 //128: 128, 1      0 -32645
 //192: 1, 127      -32645 0
 
-static unsigned trigoCached = 1;
-static unsigned trigoUnCached = 1;
-
 struct Trigo {
   virtual ~Trigo() = default;
 
   uint16_t period = 360; //default period 360
   Trigo(uint16_t period = 360) {this->period = period;}
-  float sinValue[3]; uint16_t sinAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of sinValue=sin(sinAngle) for tilt, pan and roll
-  float cosValue[3]; uint16_t cosAngle[3] = {UINT16_MAX,UINT16_MAX,UINT16_MAX}; //caching of cosValue=cos(cosAngle) for tilt, pan and roll
-  virtual float sinBase(uint16_t angle) {return sinf(M_TWOPI * angle / period);}
-  virtual float cosBase(uint16_t angle) {return cosf(M_TWOPI * angle / period);}
-  int16_t sin(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
-    if (sinAngle[cache012] != angle) {sinAngle[cache012] = angle; sinValue[cache012] = sinBase(angle);trigoUnCached++;} else trigoCached++;
-    return factor * sinValue[cache012];
-  };
-  int16_t cos(int16_t factor, uint16_t angle, uint8_t cache012 = 0) {
-    if (cosAngle[cache012] != angle) {cosAngle[cache012] = angle; cosValue[cache012] = cosBase(angle);trigoUnCached++;} else trigoCached++;
-    return factor * cosValue[cache012];
-  };
+  uint16_t phase(uint16_t angle) const {return period ? (uint32_t)(angle % period) * 65536 / period : 0;} //period to 0..65535
+  virtual float sinBase(uint16_t angle) {return sinQ15(phase(angle)) / 32767.0f;}
+  virtual float cosBase(uint16_t angle) {return cosQ15(phase(angle)) / 32767.0f;}
+  int16_t sin(int16_t factor, uint16_t angle) {return factor * sinBase(angle);}
+  int16_t cos(int16_t factor, uint16_t angle) {return factor * cosBase(angle);}
   // https://msl.cs.uiuc.edu/planning/node102.html
   Coord3D pan(Coord3D in, Coord3D middle, uint16_t angle) {
     Coord3D inM = in - middle;
     Coord3D out;
-    out.x = cos(inM.x, angle, 0) + sin(inM.z, angle, 0);
+    out.x = cos(inM.x, angle) + sin(inM.z, angle);
     out.y = inM.y;
-    out.z = - sin(inM.x, angle, 0) + cos(inM.z, angle, 0);
+    out.z = - sin(inM.x, angle) + cos(inM.z, angle);
     return out + middle;
   }
   Coord3D tilt(Coord3D in, Coord3D middle, uint16_t angle) {
     Coord3D inM = in - middle;
     Coord3D out;
     out.x = inM.x;
-    out.y = cos(inM.y, angle, 1) - sin(inM.z, angle, 1);
-    out.z = sin(inM.y, angle, 1) + cos(inM.z, angle, 1);
+    out.y = cos(inM.y, angle) - sin(inM.z, angle);
+    out.z = sin(inM.y, angle) + cos(inM.z, angle);
     return out + middle;
   }
   Coord3D roll(Coord3D in, Coord3D middle, uint16_t angle) {
     Coord3D inM = in - middle;
     Coord3D out;
-    out.x = cos(inM.x, angle, 2) - sin(inM.y, angle, 2);
-    out.y = sin(inM.x, angle, 2) + cos(inM.y, angle, 2);
+    out.x = cos(inM.x, angle) - sin(inM.y, angle);
+    out.y = sin(inM.x, angle) + cos(inM.y, angle);
     out.z = inM.z;
     return out + middle;
   }
@@ -739,5 +972,3 @@ struct Trigo16: Trigo { //FastLed sin16 and cos16
   float sinBase(uint16_t angle) override {return sin16(65536.0f * angle / period) / 32645.0f;}
   float cosBase(uint16_t angle) override {return cos16(65536.0f * angle / period) / 32645.0f;}
 };
-
-static Trigo trigoTiltPanRoll(255); // Trigo8 is hardly any faster (27 vs 28 fps) (spanXY=28)
\ No newline at end of file
@@ -134,6 +134,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
           ppf("layers creating new LedsLayer instance %d\n", rowNr);
           LedsLayer *leds = new LedsLayer();
           fix->layers.push_back(leds);
+          for (LedsLayer *leds: fix->layers) leds->triggerMapping(); //more layers: all need a compose buffer
         }
         return true;
       case onDelete:
@@ -143,6 +144,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
           LedsLayer *leds = fix->layers[rowNr];
           fix->layers.erase(fix->layers.begin() + rowNr); //remove from vector
           delete leds; //remove leds itself
+          for (LedsLayer *leds: fix->layers) leds->triggerMapping(); //a single layer can draw direct again
         }
         return true;
       default: return false;
@@ -179,6 +181,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
           ppf("effect creating new LedsLayer instance %d\n", rowNr);
           LedsLayer *leds = new LedsLayer();
           fix->layers.push_back(leds);
+          for (LedsLayer *leds: fix->layers) leds->triggerMapping(); //more layers: all need a compose buffer
         }
 
         if (rowNr < fix->layers.size()) {
@@ -208,7 +211,7 @@ inline uint16_t getRGBWsize(uint16_t nleds){
               leds->effectDimension = leds->effect->dim();
               leds->triggerMapping();
               //initEffect is called after mapping done to make sure dimensions are right before controls are done...
-              doInitEffectRowNr = rowNr;
+              leds->doInitEffect = true;
             }
             else {
               initEffect(*leds, rowNr);
@@ -260,7 +263,6 @@ inline uint16_t getRGBWsize(uint16_t nleds){
             ppf("initProjection leds[%d] projection:%s a:%d\n", rowNr, leds->projection?leds->projection->name():"None", leds->projectionData.bytesAllocated);
 
             leds->projectionData.clear(); //delete effectData memory so it can be rebuild
-            leds->projectionData.read<uint8_t>(); leds->projectionData.begin(); //allocate minimum amount for projectionData (chunk of 32 bytes) to avoid control defaults to be removed
 
             variable.preDetails(); //set all positive var N orders to negative
             mdl->setValueRowNr = rowNr;
@@ -268,8 +270,6 @@ inline uint16_t getRGBWsize(uint16_t nleds){
             variable.postDetails(rowNr);
 
             mdl->setValueRowNr = UINT8_MAX;
-
-            leds->projectionData.alertIfChanged = true; //find out when it is changing, eg when projections change, in that case controls are lost...solution needed for that...
           }
           else
             leds->projection = nullptr;
@@ -363,6 +363,59 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       default: return false;
     }});
 
+    ui->initSelect(tableVar, "blend", UINT8_MAX, false, [this](EventArguments) { switch (eventType) {
+      case onSetValue:
+        for (size_t rowNr = 0; rowNr < fix->layers.size(); rowNr++)
+          variable.setValue(fix->layers[rowNr]->blendMode, rowNr);
+        return true;
+      case onUI: {
+        variable.setComment("How the layer is composed on the layers below");
+        JsonArray options = variable.setOptions();
+        options.add("Alpha"); //b_alpha
+        options.add("Add"); //b_add
+        options.add("Max"); //b_max
+        options.add("Multiply"); //b_multiply
+        options.add("Screen"); //b_screen
+        return true; }
+      case onChange:
+        if (rowNr < fix->layers.size())
+          fix->layers[rowNr]->blendMode = min(variable.getValue(rowNr).as<uint8_t>(), (uint8_t)(b_count - 1));
+        return true;
+      default: return false;
+    }});
+
+    ui->initSlider(tableVar, "opacity", UINT8_MAX, 0, 255, false, [this](EventArguments) { switch (eventType) {
+      case onSetValue:
+        for (size_t rowNr = 0; rowNr < fix->layers.size(); rowNr++)
+          variable.setValue(fix->layers[rowNr]->opacity, rowNr);
+        return true;
+      case onChange:
+        if (rowNr < fix->layers.size()) {
+          LedsLayer *leds = fix->layers[rowNr];
+          leds->opacity = variable.getValue(rowNr);
+          if (leds->opacity < 255 && !leds->ledsV) leds->triggerMapping(); //opacity needs a compose buffer
+        }
+        return true;
+      default: return false;
+    }});
+
+    ui->initCheckBox(tableVar, "buffer", UINT8_MAX, false, [this](EventArguments) { switch (eventType) {
+      case onSetValue:
+        for (size_t rowNr = 0; rowNr < fix->layers.size(); rowNr++)
+          variable.setValue(fix->layers[rowNr]->virtualBuffer, rowNr);
+        return true;
+      case onUI:
+        variable.setComment("Effect draws in its own buffer (full color, more memory)");
+        return true;
+      case onChange:
+        if (rowNr < fix->layers.size()) {
+          fix->layers[rowNr]->virtualBuffer = variable.getValue(rowNr);
+          fix->layers[rowNr]->triggerMapping(); //buffer is (de)allocated in addPixelsPost
+        }
+        return true;
+      default: return false;
+    }});
+
     ui->initText(tableVar, "size", nullptr, 32, true, [this](EventArguments) { switch (eventType) {
       case onSetValue: {
         // for (std::vector<LedsLayer *>::iterator leds=fix->layers.begin(); leds!=fix->layers.end(); ++leds) {
@@ -378,6 +431,22 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       default: return false;
     }});
 
+    ui->initText(tableVar, "mapping", nullptr, 32, true, [this](EventArguments) { switch (eventType) {
+      case onSetValue: {
+        uint8_t rowNr = 0;
+        for (LedsLayer *leds:fix->layers) {
+          StarString message;
+          message.format("%d B", leds->mappingBytes());
+          variable.setValue(JsonString(message.getString()), rowNr);
+          rowNr++;
+        }
+        return true; }
+      case onUI:
+        variable.setComment("Memory used by the mapping");
+        return true;
+      default: return false;
+    }});
+
     // ui->initSelect(parentVar, "layout", 0, false, [](EventArguments) { switch (eventType) {
     //   case onUI: {
     //     variable.setComment("WIP");
@@ -391,8 +460,6 @@ inline uint16_t getRGBWsize(uint16_t nleds){
     //   default: return false;
     // }}); //effect Layout
 
-    ui->initSlider(parentVar, "Blending", &fix->globalBlend);
-
     addPresets(parentVar.var);
 
     #ifdef STARBASE_USERMOD_E131
@@ -424,14 +491,13 @@ inline uint16_t getRGBWsize(uint16_t nleds){
 
     random16_set_seed(sys->now);
 
-    //set new frame
-    if (sys->now - frameMillis >= 1000.0/fix->fps - 1 && fix->mappingStatus == 0) { //floorf to make it no wait to go beyond 1000 fps ;-)
+    bool outputReady = true;
+    #ifdef STARLIGHT_PIPELINE
+      outputReady = !fix->pipelined() || !fix->frameQueue.full(); //do not render frames the output task cannot take
+    #endif
 
-      //reset pixelsToBlend if multiple leds effects
-      // ppf(" %d-%d", fix->pixelsToBlend.size(), fix->nrOfLeds);
-      if (fix->layers.size() > 1) //if more then one effect
-        for (uint16_t indexP=0; indexP < fix->pixelsToBlend.size(); indexP++)
-          fix->pixelsToBlend[indexP] = false;
+    //set new frame
+    if (sys->now - frameMillis >= 1000.0/fix->fps - 1 && (fix->mappingStatus == 0 || fix->mappingStatus == 3) && outputReady) { //floorf to make it no wait to go beyond 1000 fps ;-)
 
       frameMillis = sys->now;
 
@@ -441,10 +507,11 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       //  run the next frame of the effect
       for (uint8_t rowNr = 0; rowNr < fix->layers.size(); rowNr++) {
         LedsLayer *leds = fix->layers[rowNr];
-        if (leds->effect && !leds->doMap) { // don't run effect while remapping or non existing effect (default UINT16_MAX)
+        if (leds->effect && (!leds->doMap || leds->mapBuilding)) { // don't run effect while remapping (unless in slices) or non existing effect (default UINT16_MAX)
           // ppf(" %s %d,%d,%d - %d,%d,%d (%d,%d,%d)", leds->effect->name(), leds->start.x, leds->start.y, leds->start.z, leds->end.x, leds->end.y, leds->end.z, leds->size.x, leds->size.y, leds->size.z );
 
           leds->effectData.begin(); //sets the effectData pointer back to 0 so loop effect can go through it
+          leds->frameTransform(); //XYZ of the projection for this frame
 
           mdl->getValueRowNr = rowNr;
           leds->effect->loop(*leds);
@@ -473,21 +540,23 @@ inline uint16_t getRGBWsize(uint16_t nleds){
 
           // if (leds->projectionNr == p_TiltPanRoll || leds->projectionNr == p_Preset1)
           //   leds->fadeToBlackBy(50);
+        }
+      }
 
-          //loop over mapped pixels and set pixelsToBlend to true
-          if (fix->layers.size() > 1) { //if more then one effect
-            for (const std::vector<uint16_t>& mappingTableIndex: leds->mappingTableIndexes) {
-              for (const uint16_t indexP: mappingTableIndex)
-                fix->pixelsToBlend[indexP] = true;
-            }
-            for (const PhysMap &physMap: leds->mappingTable) {
-              if (physMap.mapType == m_onePixel)
-                fix->pixelsToBlend[physMap.indexP] = true;
-            }
-          }
+      //compose: blend the layer buffers bottom to top into ledsP, starting from black
+      //  a layer without buffer (one layer, full opacity) has drawn in ledsP already
+      bool drawn = false; //ledsP holds this frame already
+      for (LedsLayer *leds: fix->layers) {
+        if (!leds->effect || (leds->doMap && !leds->mapBuilding)) continue;
+        if (leds->ledsV) {
+          if (!drawn) fill_solid(fix->ledsP, fix->nrOfLeds, CRGB::Black);
+          leds->compose();
         }
+        drawn = true;
       }
 
+      fix->frameReady(); //outputs get the complete frame
+
       frameCounter++;
     }
     else {
@@ -535,7 +604,8 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       ppf("initEffect leds[%d] effect:%s a:%d (%d,%d,%d)\n", rowNr, leds.effect->name(), leds.effectData.bytesAllocated, leds.size.x, leds.size.y, leds.size.z);
 
       leds.effectData.clear(); //delete effectData memory so it can be rebuild
-      leds.effect->loop(leds); leds.effectData.begin(); //do a loop to set effectData right to avoid control defaults to be removed
+      memset(leds.controlsData, 0, sizeof(leds.controlsData)); //setup sets the defaults of typed controls (initControls)
+      leds.effectData.reserve(leds.effect->dataSize(leds)); //controls and state in one chunk (grows later if 0 or too small, the controls do not move)
 
       Variable variable = Variable("layers", "effect");
       variable.preDetails();
@@ -544,7 +614,5 @@ inline uint16_t getRGBWsize(uint16_t nleds){
       variable.postDetails(rowNr);
       mdl->setValueRowNr = UINT8_MAX;
 
-      leds.effectData.alertIfChanged = true; //find out when it is changing, eg when projections change, in that case controls are lost...solution needed for that...
-
 
   }
@@ -16,13 +16,12 @@
 class LedModEffects:public SysModule {
 
 public:
-  bool newFrame = false; //for other modules (DDP)
+  bool newFrame = false; //a frame was rendered in this loop (outputs use fix->frameNr)
   unsigned long frameCounter = 0;
 
   std::vector<Effect *> effects;
   std::vector<Projection *> projections;
 
-  uint8_t doInitEffectRowNr = UINT8_MAX;
 
   LedModEffects();
 
@@ -80,6 +80,32 @@
   void LedModFixture::setup() {
     SysModule::setup();
 
+    //front buffer allocated once: the drivers keep pointing to it
+    size_t bytes = STARLIGHT_MAXLEDS * sizeof(CRGB);
+    CRGB *front = nullptr;
+    if (psramFound())
+      front = (CRGB *)ps_malloc(bytes);
+    else if (ESP.getMaxAllocHeap() >= bytes * 2) //leave room for the rest
+      front = (CRGB *)malloc(bytes);
+    if (front) {
+      fill_solid(front, STARLIGHT_MAXLEDS, CRGB::Black);
+      ledsF = front;
+    } else
+      ppf("dev Fixture front buffer of %d B not allocated, outputs read the frame while rendering\n", bytes);
+
+    #ifdef STARLIGHT_PIPELINE
+      //output task on core 0 (with WiFi), the loop task renders on core 1, frames in between go through the frame queue
+      if (ledsF != ledsP) {
+        for (uint8_t slot = 0; slot < frameQueueLength; slot++)
+          frameQueue.slots[slot] = (CRGB *)(psramFound()?ps_malloc(bytes):malloc(bytes));
+        outputMutex = xSemaphoreCreateMutex();
+        if (frameQueue.slots[frameQueueLength - 1] && outputMutex)
+          xTaskCreatePinnedToCore(outputTask, "outputTask", 6144, nullptr, 1, &outputTaskHandle, 0);
+      }
+      if (!outputTaskHandle)
+        ppf("dev Fixture output task not started, render and output in the loop task\n");
+    #endif
+
     const Variable parentVar = ui->initAppMod(Variable(), name, 1100);
 
     Variable currentVar = ui->initCheckBox(parentVar, "on", true, false, [](EventArguments) { switch (eventType) {
@@ -118,87 +144,16 @@
         }
         return true;
       case onLoop: {
-        if (!web->isBusy && mappingStatus == 0 && bytesPerPixel && !doSendFixtureDefinition && web->ws.getClients().length()) { //not remapping and clients exists
+        if (!web->isBusy && (mappingStatus == 0 || mappingStatus == 3) && bytesPerPixel && !doSendFixtureDefinition && web->ws.getClients().length()) { //not remapping and clients exists
           variable.var["interval"] = max(nrOfLeds * web->ws.count()/200, 16U)*10; //interval in ms * 10, not too fast //from cs to ms
 
-          #define headerBytesPreview 5
-          // ppf("(%d %d %d,%d,%d)", len, headerBytesPreview + nrOfLeds * bytesPerPixel, fixSize.x, fixSize.y, fixSize.z);
-          size_t len = min(headerBytesPreview + nrOfLeds * bytesPerPixel, PACKAGE_SIZE);
-          AsyncWebSocketMessageBuffer *wsBuf= web->ws.makeBuffer(len); //global wsBuf causes crash in audio sync module!!!
-          if (wsBuf) {
-            wsBuf->lock();
-            byte* buffer = wsBuf->get();
-            //new values
-            buffer[0] = 2; //userFun id
-            //rotations
-            if (viewRotation == 0) {
-              buffer[1] = 0;
-              buffer[2] = 0;
-              buffer[3] = 0;
-            } else if (viewRotation == 1) { //tilt
-              buffer[1] = beat8(1);//, 0, 255);
-              buffer[2] = 0;//beatsin8(4, 250, 5);
-              buffer[3] = 0;//beatsin8(6, 255, 5);
-            } else if (viewRotation == 2) { //pan
-              buffer[1] = 0;//beatsin8(4, 250, 5);
-              buffer[2] = beat8(1);//, 0, 255);
-              buffer[3] = 0;//beatsin8(6, 255, 5);
-            } else if (viewRotation == 3) { //roll
-              buffer[1] = 0;//beatsin8(4, 250, 5);
-              buffer[2] = 0;//beatsin8(6, 255, 5);
-              buffer[3] = beat8(1);//, 0, 255);
-            } else if (viewRotation == 4) {
-              buffer[1] = head.x;
-              buffer[2] = head.y;
-              buffer[3] = head.z;
+          #ifdef STARLIGHT_PIPELINE
+            if (pipelined()) {
+              previewRequested = true; //the output task sends its next frame
+              return true;
             }
-            buffer[4] = bytesPerPixel;
-            uint16_t previewBufferIndex = headerBytesPreview;
-
-            // send leds preview to clients
-            for (size_t indexP = 0; indexP < nrOfLeds; indexP++) {
-
-              if (previewBufferIndex + bytesPerPixel > PACKAGE_SIZE) {
-                //send the buffer and create a new one
-                web->sendBuffer(wsBuf, true);
-                delay(10);
-                buffer[0] = 2; //userFun id
-                buffer[1] = UINT8_MAX; //indicates follow up package
-                buffer[2] = indexP/256; //fixSize.x%256;
-                buffer[3] = indexP%256; //fixSize.x%256;
-                buffer[4] = bytesPerPixel;
-                // ppf("@");
-                // ppf("new buffer created i:%d p:%d r:%d r6:%d\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6);
-                previewBufferIndex = headerBytesPreview;
-              }
-
-              uint16_t indexP2 = indexP;
-              //causes too much flickering for some reason, so leave it for now
-              // #ifdef STARLIGHT_LIVE_MAPPING
-              //   indexP2 = mapLed(indexP);
-              // #endif
-
-              if (bytesPerPixel == 1) {
-                //encode rgb in 8 bits: 3 for red, 3 for green, 2 for blue (0xE0 = 01110000)
-                buffer[previewBufferIndex++] = (ledsP[indexP2].red & 0xE0) | ((ledsP[indexP2].green & 0xE0)>>3) | (ledsP[indexP2].blue >> 6);
-              }
-              else if (bytesPerPixel == 2) {
-                //encode rgb in 16 bits: 5 for red, 6 for green, 5 for blue
-                buffer[previewBufferIndex++] = (ledsP[indexP2].red & 0xF8) | (ledsP[indexP2].green >> 5); // Take 5 bits of Red component and 3 bits of G component
-                buffer[previewBufferIndex++] = ((ledsP[indexP2].green & 0x1C) << 3) | (ledsP[indexP2].blue  >> 3); // Take remaining 3 Bits of G component and 5 bits of Blue component
-              }
-              else {
-                buffer[previewBufferIndex++] = ledsP[indexP2].red;
-                buffer[previewBufferIndex++] = ledsP[indexP2].green;
-                buffer[previewBufferIndex++] = ledsP[indexP2].blue;
-              }
-            } //loop
-
-            web->sendBuffer(wsBuf, true);
-
-            wsBuf->unlock();
-            web->ws._cleanBuffers();
-          }
+          #endif
+          previewSend();
 
         }
 
@@ -277,6 +232,24 @@
       default: return false;
     }});
 
+    ui->initButton(currentVar, "toBinary", false, [this](EventArguments) { switch (eventType) {
+      case onUI:
+        variable.setComment("Convert to F_ixture.bin (faster load)");
+        return true;
+      case onChange: {
+        char fileName[32] = "";
+        char binName[32] = "";
+        if (files->seqNrToName(fileName, fixtureNr, "F_") && fixtureToBin(fileName, binName, sizeof(binName))) {
+          //select the binary fixture
+          Variable("Fixture", "fixture").triggerEvent(onUI); //rebuild options
+          uint8_t value = ui->selectOptionToValue("Fixture.fixture", binName);
+          if (value != UINT8_MAX)
+            mdl->setValue("Fixture", "fixture", value);
+        }
+        return true; }
+      default: return false;
+    }});
+
     #if STARLIGHT_PHYSICAL_DRIVER | STARLIGHT_VIRTUAL_DRIVER
       ui->initSlider(parentVar, "gammaRed", &gammaRed, 0, 255, false, [this](EventArguments) { switch (eventType) {
         case onChange:
@@ -316,6 +289,23 @@
       default: return false;
     }});
 
+    #ifdef STARLIGHT_PIPELINE
+      if (pipelined())
+        ui->initNumber(parentVar, "outputFps", &outputFps, 0, UINT16_MAX, true, [this](EventArguments) { switch (eventType) {
+          case onUI:
+            variable.setComment("Output task");
+            return true;
+          case onLoop1s:
+            variable.setValue(outputFrameCounter);
+            outputFrameCounter = 0;
+            web->addResponse(variable.var, "comment", "queue %d/%d dropped %d", maxQueueDepth, frameQueueLength, droppedFrameCounter);
+            maxQueueDepth = frameQueue.depth();
+            droppedFrameCounter = 0;
+            return true;
+          default: return false;
+        }});
+    #endif
+
     ui->initCheckBox(parentVar, "tickerTape", &showTicker);
 
     ui->initCheckBox(parentVar, "showDriver", &showDriver, false, [this](EventArguments) { switch (eventType) {
@@ -361,11 +351,13 @@
 
   void LedModFixture::loop() {
     //use lastMappingMillis and not loop1s as doMap needs to start asap, not wait for next second
-    if (mappingStatus == 1 && sys->now - lastMappingMillis >= 1000) { //not more then once per second (for E131)
+    if (mappingStatus == 1 && !mapSlicesStart() && sys->now - lastMappingMillis >= 1000) { //not more then once per second (for E131)
       lastMappingMillis = sys->now;
       mapInitAlloc();
     }
 
+    bool swapped = mappingStatus == 3 && mapSlice();
+
     #ifdef STARLIGHT_USERMOD_AUDIOSYNC
 
       if (viewRotation == 4) {
@@ -376,17 +368,604 @@
 
     #endif
 
-    if (showDriver && !web->isBusy && mappingStatus == 0) //mappingStatus: otherwise driverShow in virtual driver hangs
+    if (!pipelined() && showDriver && !web->isBusy && (mappingStatus == 0 || mappingStatus == 3) && (!swapped || ledsF != ledsP)) //mappingStatus: otherwise driverShow in virtual driver hangs, swapped: cleared layers, show after the effects ran (single buffered)
       driverShow();
   }
 
+  //send ledsF to the preview canvas of the ui clients
+  void LedModFixture::previewSend() {
+    xSemaphoreTake(web->wsMutex, portMAX_DELAY); //the output task sends in parallel with the loop task
+    #define headerBytesPreview 5
+    // ppf("(%d %d %d,%d,%d)", len, headerBytesPreview + nrOfLeds * bytesPerPixel, fixSize.x, fixSize.y, fixSize.z);
+    size_t len = min(headerBytesPreview + nrOfLeds * bytesPerPixel, PACKAGE_SIZE);
+    AsyncWebSocketMessageBuffer *wsBuf= web->ws.makeBuffer(len); //global wsBuf causes crash in audio sync module!!!
+    if (wsBuf) {
+      wsBuf->lock();
+      byte* buffer = wsBuf->get();
+      //new values
+      buffer[0] = 2; //userFun id
+      //rotations
+      if (viewRotation == 0) {
+        buffer[1] = 0;
+        buffer[2] = 0;
+        buffer[3] = 0;
+      } else if (viewRotation == 1) { //tilt
+        buffer[1] = beat8(1);//, 0, 255);
+        buffer[2] = 0;//beatsin8(4, 250, 5);
+        buffer[3] = 0;//beatsin8(6, 255, 5);
+      } else if (viewRotation == 2) { //pan
+        buffer[1] = 0;//beatsin8(4, 250, 5);
+        buffer[2] = beat8(1);//, 0, 255);
+        buffer[3] = 0;//beatsin8(6, 255, 5);
+      } else if (viewRotation == 3) { //roll
+        buffer[1] = 0;//beatsin8(4, 250, 5);
+        buffer[2] = 0;//beatsin8(6, 255, 5);
+        buffer[3] = beat8(1);//, 0, 255);
+      } else if (viewRotation == 4) {
+        buffer[1] = head.x;
+        buffer[2] = head.y;
+        buffer[3] = head.z;
+      }
+      buffer[4] = bytesPerPixel;
+      uint16_t previewBufferIndex = headerBytesPreview;
+
+      // send leds preview to clients
+      for (size_t indexP = 0; indexP < nrOfLeds; indexP++) {
+
+        if (previewBufferIndex + bytesPerPixel > PACKAGE_SIZE) {
+          //send the buffer and create a new one
+          web->sendBuffer(wsBuf, true);
+          delay(10);
+          buffer[0] = 2; //userFun id
+          buffer[1] = UINT8_MAX; //indicates follow up package
+          buffer[2] = indexP/256; //fixSize.x%256;
+          buffer[3] = indexP%256; //fixSize.x%256;
+          buffer[4] = bytesPerPixel;
+          // ppf("@");
+          // ppf("new buffer created i:%d p:%d r:%d r6:%d\n", indexP, previewBufferIndex, (nrOfLeds - indexP), (nrOfLeds - indexP) * 6);
+          previewBufferIndex = headerBytesPreview;
+        }
+
+        uint16_t indexP2 = indexP;
+        //causes too much flickering for some reason, so leave it for now
+        // #ifdef STARLIGHT_LIVE_MAPPING
+        //   indexP2 = mapLed(indexP);
+        // #endif
+
+        if (bytesPerPixel == 1) {
+          //encode rgb in 8 bits: 3 for red, 3 for green, 2 for blue (0xE0 = 01110000)
+          buffer[previewBufferIndex++] = (ledsF[indexP2].red & 0xE0) | ((ledsF[indexP2].green & 0xE0)>>3) | (ledsF[indexP2].blue >> 6);
+        }
+        else if (bytesPerPixel == 2) {
+          //encode rgb in 16 bits: 5 for red, 6 for green, 5 for blue
+          buffer[previewBufferIndex++] = (ledsF[indexP2].red & 0xF8) | (ledsF[indexP2].green >> 5); // Take 5 bits of Red component and 3 bits of G component
+          buffer[previewBufferIndex++] = ((ledsF[indexP2].green & 0x1C) << 3) | (ledsF[indexP2].blue  >> 3); // Take remaining 3 Bits of G component and 5 bits of Blue component
+        }
+        else {
+          buffer[previewBufferIndex++] = ledsF[indexP2].red;
+          buffer[previewBufferIndex++] = ledsF[indexP2].green;
+          buffer[previewBufferIndex++] = ledsF[indexP2].blue;
+        }
+      } //loop
+
+      web->sendBuffer(wsBuf, true);
+
+      wsBuf->unlock();
+      web->ws._cleanBuffers();
+    }
+    xSemaphoreGive(web->wsMutex);
+  }
+
+  //the frame in ledsP is complete: hand it over to the outputs
+  //  a copy, not a pointer swap: effects build on the previous frame in ledsP (e.g. fadeToBlackBy) and the drivers keep their buffer
+  void LedModFixture::frameReady() {
+    #ifdef STARLIGHT_PIPELINE
+      if (pipelined()) {
+        if (frameQueue.push(ledsP, nrOfLeds))
+          xTaskNotifyGive(outputTaskHandle); //wake up the output task
+        else
+          droppedFrameCounter++; //output task too slow
+        maxQueueDepth = max(maxQueueDepth, frameQueue.depth());
+        return;
+      }
+    #endif
+    if (ledsF != ledsP) memcpy(ledsF, ledsP, nrOfLeds * sizeof(CRGB));
+    frameNr++;
+  }
+
+  #ifdef STARLIGHT_PIPELINE
+    //ship the queued frames: driver show, network outputs and preview, in parallel with rendering the next frame
+    void LedModFixture::outputTask(void *parameter) {
+      for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)); //woken up by frameReady
+        while (fix->frameQueue.depth() && xSemaphoreTake(fix->outputMutex, portMAX_DELAY) == pdTRUE) {
+          fix->frameQueue.pop(fix->ledsF);
+          fix->frameNr++;
+          fix->outputFrameCounter++;
+
+          uint8_t mappingStatus = fix->mappingStatus; //atomic, set by the loop task
+          if (fix->showDriver && !web->isBusy && (mappingStatus == 0 || mappingStatus == 3))
+            fix->driverShow();
+
+          for (std::function<void()> &frameOutput: fix->frameOutputs)
+            frameOutput();
+
+          if (fix->previewRequested.exchange(false))
+            fix->previewSend();
+
+          xSemaphoreGive(fix->outputMutex);
+        }
+      }
+    }
+
+    void LedModFixture::addFrameOutput(std::function<void()> frameOutput) {
+      if (outputMutex) xSemaphoreTake(outputMutex, portMAX_DELAY); //output task may be running
+      frameOutputs.push_back(frameOutput);
+      if (outputMutex) xSemaphoreGive(outputMutex);
+    }
+  #endif
+
+  //start a remap in slices if only layers change (same fixture and projections), the live mappings keep rendering
+  bool LedModFixture::mapSlicesStart() {
+    if (!pixelCache || pixelCacheSize != nrOfLeds || doAllocPins || doSendFixtureDefinition) return false;
+    for (LedsLayer *leds: layers)
+      if (leds->doMap && !leds->mappingUsable()) return false;
+
+    uint8_t rowNr = 0;
+    for (LedsLayer *leds: layers) {
+      if (leds->doMap) { //also restarts a layer which is building
+        leds->mapBuilding = true;
+        leds->swapMapping();
+        leds->addPixelsPre(rowNr);
+        leds->swapMapping();
+      }
+      rowNr++;
+    }
+
+    start = millis();
+    mapSliceIndexP = 0;
+    mappingStatus = 3; //mapping in slices
+    return true;
+  }
+
+  #define mapSliceMicros 4000 //mapping time per loop, rendering goes on in between
+  #define mapSlicePixels 256 //pixels per check of the time
+
+  bool LedModFixture::mapSlice() {
+    unsigned long sliceStart = micros();
+    while (mapSliceIndexP < pixelCacheSize && micros() - sliceStart < mapSliceMicros) {
+      uint16_t sliceEnd = min(mapSliceIndexP + mapSlicePixels, (int)pixelCacheSize);
+      uint8_t rowNr = 0;
+      for (LedsLayer *leds: layers) {
+        if (leds->mapBuilding) {
+          leds->swapMapping(); //build in the shadow
+          for (indexP = mapSliceIndexP; indexP < sliceEnd; indexP++) {
+            const uint16_t *pixel = pixelCache + indexP * 3;
+            leds->addPixel({pixel[0], pixel[1], pixel[2]}, rowNr);
+          }
+          leds->swapMapping();
+        }
+        rowNr++;
+      }
+      mapSliceIndexP = sliceEnd;
+    }
+
+    if (mapSliceIndexP < pixelCacheSize) return false;
+
+    //all pixels done: swap in the new mappings
+    uint8_t rowNr = 0;
+    for (LedsLayer *leds: layers) {
+      if (leds->mapBuilding) {
+        leds->fill_solid(CRGB::Black); //the new mapping may not cover all pixels of the old one
+        leds->swapMapping();
+        leds->mapBuilding = false;
+        leds->addPixelsPost(rowNr);
+      }
+      rowNr++;
+    }
+    mappingStatus = 0;
+    ppf("mapSlice done %d pixels %d ms\n", pixelCacheSize, millis() - start);
+    return true;
+  }
+
+  //mapping cache file: header, pins, pixels (x,y,z uint16), then per layer: header, mappingTable, mappingTableOffsets, mappingTableIndexes
+  #define mapCacheVersion 2
+
+  struct MapCacheHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t ledFactor;
+    uint8_t ledSize;
+    uint8_t ledShape;
+    uint32_t fixtureHash;
+    Coord3D fixSize;
+    uint16_t nrOfLeds;
+    uint8_t nrOfPins;
+    uint8_t nrOfLayers;
+    uint8_t physMapSize; //compact or wide PhysMap
+  };
+
+  struct MapCachePin {
+    uint8_t pin;
+    char details[sizeof(PinObject::details)];
+  };
+
+  struct MapCacheLayer {
+    uint32_t mappingKey;
+    Coord3D size, start, middle, end;
+    uint16_t mappingTableSize; //can be more than used (the table keeps its size when remapping)
+    uint16_t mappingTableSizeUsed;
+    uint16_t mappingTableIndexesSizeUsed;
+    uint16_t nrOfIndexes;
+    uint8_t rowNr;
+    uint8_t projectionDimension;
+  };
+
+  //hash of the fixture file, read in blocks
+  static uint32_t fileHash(const char *fileName) {
+    uint32_t hash = hashBytes(nullptr, 0);
+    File f = files->open(fileName, "r");
+    if (f) {
+      uint8_t block[512];
+      size_t len;
+      while ((len = f.read(block, sizeof(block))) > 0) hash = hashBytes(block, len, hash);
+      f.close();
+    }
+    return hash;
+  }
+
+  //restore a blocking mapping from the mapping cache, false if not cached (then the fixture is parsed)
+  bool LedModFixture::mapCacheLoad(uint32_t fixtureHash) {
+    if (doSendFixtureDefinition) return false; //the preview gets its pixels while parsing
+    File f = files->open(mapCacheFile, "r");
+    if (!f) return false;
+
+    MapCacheHeader header;
+    if (f.read((uint8_t *)&header, sizeof(header)) != sizeof(header) || strncmp(header.magic, "SLMC", 4) != 0 || header.version != mapCacheVersion || header.physMapSize != sizeof(PhysMap)
+        || header.fixtureHash != fixtureHash || header.nrOfLeds == 0 || header.nrOfLeds > STARLIGHT_MAXLEDS) {
+      f.close();
+      return false;
+    }
+
+    start = millis();
+    ledFactor = header.ledFactor;
+    ledSize = header.ledSize;
+    ledShape = header.ledShape;
+    fixSize = header.fixSize;
+    nrOfLeds = header.nrOfLeds;
+
+    pass = 2;
+    addPixelsPre(); //clears the layers to map (and sets their mappingKey), deallocates pins, allocates the pixel cache
+    if (!pixelCache) { //needed to map the layers which are not cached
+      f.close();
+      return false;
+    }
+
+    size_t bytes = nrOfLeds * 3 * sizeof(uint16_t);
+    bool ok = f.read((uint8_t *)pixelCache, bytes) == bytes;
+
+    for (uint8_t i = 0; ok && i < header.nrOfPins; i++) {
+      MapCachePin cachePin;
+      ok = f.read((uint8_t *)&cachePin, sizeof(cachePin)) == sizeof(cachePin);
+      cachePin.details[sizeof(cachePin.details) - 1] = '\0';
+      if (ok && doAllocPins) pinsM->allocatePin(cachePin.pin, "Leds", cachePin.details);
+    }
+
+    //restore the tables of layers with the same mappingKey
+    std::vector<LedsLayer *> restored;
+    uint32_t signature = fixtureHash; //as in mapCacheSave
+    for (uint8_t i = 0; ok && i < header.nrOfLayers; i++) {
+      MapCacheLayer cacheLayer;
+      ok = f.read((uint8_t *)&cacheLayer, sizeof(cacheLayer)) == sizeof(cacheLayer);
+      if (!ok) break;
+      signature = hashBytes(&cacheLayer.mappingKey, sizeof(cacheLayer.mappingKey), signature);
+      size_t tableBytes = cacheLayer.mappingTableSize * sizeof(PhysMap);
+      size_t offsetsBytes = (cacheLayer.mappingTableIndexesSizeUsed + 1) * sizeof(uint16_t);
+      size_t indexesBytes = cacheLayer.nrOfIndexes * sizeof(uint16_t);
+
+      LedsLayer *leds = cacheLayer.rowNr < layers.size()?layers[cacheLayer.rowNr]:nullptr;
+      if (leds && leds->doMap && leds->projection && leds->mappingKey == cacheLayer.mappingKey) {
+        leds->size = cacheLayer.size;
+        leds->start = cacheLayer.start;
+        leds->middle = cacheLayer.middle;
+        leds->end = cacheLayer.end;
+        leds->projectionDimension = cacheLayer.projectionDimension;
+        leds->mappingTable.resize(cacheLayer.mappingTableSize);
+        leds->mappingTableSizeUsed = cacheLayer.mappingTableSizeUsed;
+        leds->mappingTableOffsets.resize(cacheLayer.mappingTableIndexesSizeUsed + 1);
+        leds->mappingTableIndexesSizeUsed = cacheLayer.mappingTableIndexesSizeUsed;
+        leds->mappingTableIndexes.resize(cacheLayer.nrOfIndexes);
+        ok = f.read((uint8_t *)leds->mappingTable.data(), tableBytes) == tableBytes 
+          && f.read((uint8_t *)leds->mappingTableOffsets.data(), offsetsBytes) == offsetsBytes
+          && f.read((uint8_t *)leds->mappingTableIndexes.data(), indexesBytes) == indexesBytes;
+        restored.push_back(leds);
+      } else
+        ok = f.seek(f.position() + tableBytes + offsetsBytes + indexesBytes);
+    }
+    f.close();
+
+    if (!ok) {
+      ppf("dev mapCacheLoad %s corrupt, parse fixture\n", mapCacheFile);
+      files->remove(mapCacheFile);
+      return false; //the layers still have doMap so the parse maps them again
+    }
+
+    //the other layers are mapped from the cached pixels
+    uint8_t rowNr = 0;
+    for (LedsLayer *leds: layers) {
+      if (leds->doMap && std::find(restored.begin(), restored.end(), leds) == restored.end()) {
+        for (indexP = 0; indexP < nrOfLeds; indexP++) {
+          const uint16_t *pixel = pixelCache + indexP * 3;
+          leds->addPixel({pixel[0], pixel[1], pixel[2]}, rowNr);
+        }
+      }
+      rowNr++;
+    }
+    indexP = nrOfLeds;
+    mapCacheSignature = signature; //mapCacheSave only writes if layers have been mapped again
+
+    ppf("mapCacheLoad %d pixels, %d of %d layers restored %d ms\n", nrOfLeds, restored.size(), layers.size(), millis() - start);
+    addPixelsPost();
+    return true;
+  }
+
+  //save the fixture and the layer mappings after a blocking mapping
+  void LedModFixture::mapCacheSave(uint32_t fixtureHash) {
+    if (!pixelCache || pixelCacheSize != nrOfLeds) return;
+
+    uint32_t signature = fixtureHash;
+    size_t bytes = sizeof(MapCacheHeader) + nrOfLeds * 3 * sizeof(uint16_t);
+    uint8_t nrOfPins = 0;
+    uint8_t nrOfLayers = 0;
+    for (size_t pinNr = 0; pinNr < NUM_DIGITAL_PINS; pinNr++)
+      if (pinsM->isOwner(pinNr, "Leds")) nrOfPins++;
+    bytes += nrOfPins * sizeof(MapCachePin);
+    for (LedsLayer *leds: layers) {
+      if (leds->projection && leds->mapped) {
+        signature = hashBytes(&leds->mappingKey, sizeof(leds->mappingKey), signature);
+        bytes += sizeof(MapCacheLayer) + leds->mappingTable.size() * sizeof(PhysMap) + (leds->mappingTableOffsets.size() + leds->mappingTableIndexes.size()) * sizeof(uint16_t);
+        nrOfLayers++;
+      }
+    }
+    if (signature == mapCacheSignature) return; //no flash wear if nothing changed
+
+    files->remove(mapCacheFile);
+    if (files->usedBytes() + bytes > files->totalBytes() * 3 / 4) { //keep room for the rest
+      ppf("mapCacheSave %d B does not fit\n", bytes);
+      return;
+    }
+
+    File f = files->open(mapCacheFile, "w");
+    if (!f) return;
+
+    MapCacheHeader header{};
+    memcpy(header.magic, "SLMC", 4);
+    header.version = mapCacheVersion;
+    header.ledFactor = ledFactor;
+    header.ledSize = ledSize;
+    header.ledShape = ledShape;
+    header.fixtureHash = fixtureHash;
+    header.fixSize = fixSize;
+    header.nrOfLeds = nrOfLeds;
+    header.nrOfPins = nrOfPins;
+    header.nrOfLayers = nrOfLayers;
+    header.physMapSize = sizeof(PhysMap);
+    f.write((uint8_t *)&header, sizeof(header));
+    f.write((uint8_t *)pixelCache, nrOfLeds * 3 * sizeof(uint16_t));
+
+    for (size_t pinNr = 0; pinNr < NUM_DIGITAL_PINS; pinNr++) {
+      if (pinsM->isOwner(pinNr, "Leds")) {
+        MapCachePin cachePin{};
+        cachePin.pin = pinNr;
+        strlcpy(cachePin.details, pinsM->pinObjects[pinNr].details, sizeof(cachePin.details));
+        f.write((uint8_t *)&cachePin, sizeof(cachePin));
+      }
+    }
+
+    uint8_t rowNr = 0;
+    for (LedsLayer *leds: layers) {
+      if (leds->projection && leds->mapped) {
+        MapCacheLayer cacheLayer{};
+        cacheLayer.mappingKey = leds->mappingKey;
+        cacheLayer.size = leds->size;
+        cacheLayer.start = leds->start;
+        cacheLayer.middle = leds->middle;
+        cacheLayer.end = leds->end;
+        cacheLayer.mappingTableSize = leds->mappingTable.size();
+        cacheLayer.mappingTableSizeUsed = leds->mappingTableSizeUsed;
+        cacheLayer.mappingTableIndexesSizeUsed = leds->mappingTableIndexesSizeUsed;
+        cacheLayer.nrOfIndexes = leds->mappingTableIndexes.size();
+        cacheLayer.rowNr = rowNr;
+        cacheLayer.projectionDimension = leds->projectionDimension;
+        f.write((uint8_t *)&cacheLayer, sizeof(cacheLayer));
+        f.write((uint8_t *)leds->mappingTable.data(), leds->mappingTable.size() * sizeof(PhysMap));
+        f.write((uint8_t *)leds->mappingTableOffsets.data(), leds->mappingTableOffsets.size() * sizeof(uint16_t));
+        f.write((uint8_t *)leds->mappingTableIndexes.data(), leds->mappingTableIndexes.size() * sizeof(uint16_t));
+      }
+      rowNr++;
+    }
+
+    bool ok = f.size() == bytes;
+    f.close();
+    if (ok) {
+      mapCacheSignature = signature;
+      ppf("mapCacheSave %d B\n", bytes);
+    } else {
+      ppf("dev mapCacheSave %s write error\n", mapCacheFile);
+      files->remove(mapCacheFile);
+    }
+    files->filesChanged = true;
+  }
+
+  //binary fixture file (little endian): header, pixels (x,y,z uint16 as in the json, in pin order), pins (nr of pixels of each)
+  //  the header has size and count so no counting pass is needed, see also tools/fixture2bin.py
+  #define fixtureBinVersion 1
+  #define fixtureBinBlock 64 //pixels read / written at once
+
+  struct FixtureBinHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t ledFactor;
+    uint8_t ledSize;
+    uint8_t ledShape;
+    uint16_t size[3]; //fixSize
+    uint16_t nrOfLeds;
+    uint8_t nrOfPins;
+    uint8_t reserved;
+  };
+
+  struct FixtureBinPin {
+    uint8_t pin;
+    uint8_t reserved;
+    uint16_t nrOfLeds;
+  };
+
+  bool LedModFixture::mapFixtureBin(const char *fileName) {
+    File f = files->open(fileName, "r");
+    if (!f) return false;
+
+    FixtureBinHeader header;
+    if (f.read((uint8_t *)&header, sizeof(header)) != sizeof(header) || strncmp(header.magic, "SLFX", 4) != 0 || header.version != fixtureBinVersion) {
+      ppf("mapFixtureBin %s no binary fixture\n", fileName);
+      f.close();
+      return false;
+    }
+
+    //pins are after the pixels (written when all pixels are known)
+    std::vector<FixtureBinPin> pins(header.nrOfPins);
+    size_t pinsBytes = header.nrOfPins * sizeof(FixtureBinPin);
+    bool ok = f.seek(sizeof(header) + header.nrOfLeds * 3 * sizeof(uint16_t)) && f.read((uint8_t *)pins.data(), pinsBytes) == pinsBytes && f.seek(sizeof(header));
+
+    uint32_t pinsLeds = 0; //no wrap into a match
+    for (uint8_t i = 0; ok && i < header.nrOfPins; i++) pinsLeds += pins[i].nrOfLeds;
+    if (!ok || pinsLeds != header.nrOfLeds) {
+      ppf("dev mapFixtureBin %s corrupt\n", fileName);
+      f.close();
+      return false;
+    }
+
+    ledFactor = header.ledFactor;
+    ledSize = header.ledSize;
+    ledShape = header.ledShape;
+    fixSize = {header.size[0], header.size[1], header.size[2]};
+    nrOfLeds = header.nrOfLeds;
+
+    pass = 2; //pass 1 (counting) is in the header
+    addPixelsPre();
+
+    uint16_t block[fixtureBinBlock * 3];
+    for (uint8_t i = 0; ok && i < header.nrOfPins; i++) {
+      for (uint16_t remaining = pins[i].nrOfLeds; ok && remaining > 0;) {
+        uint16_t count = min(remaining, (uint16_t)fixtureBinBlock);
+        size_t bytes = count * 3 * sizeof(uint16_t);
+        ok = f.read((uint8_t *)block, bytes) == bytes;
+        for (uint16_t j = 0; ok && j < count; j++)
+          addPixel({block[j * 3], block[j * 3 + 1], block[j * 3 + 2]});
+        remaining -= count;
+      }
+      addPin(pins[i].pin);
+    }
+    f.close();
+
+    if (!ok) ppf("dev mapFixtureBin %s read error at pixel %d\n", fileName, indexP);
+    addPixelsPost(); //also after a read error in the pixels, as after a json parse error: the mapping is done with the pixels read
+    return true;
+  }
+
+  //parse fixture json once and write it as binary fixture with the same name (.bin), binName is set if given
+  bool LedModFixture::fixtureToBin(const char *fileName, char *binName, size_t binNameSize) {
+    char name[32];
+    strlcpy(name, fileName, sizeof(name));
+    char *ext = strrchr(name, '.');
+    if (!ext || strcmp(ext, ".json") != 0 || ext - name + sizeof(fixtureBinExt) > sizeof(name)) {
+      ppf("fixtureToBin %s not a json fixture\n", fileName);
+      return false;
+    }
+    strcpy(ext, fixtureBinExt);
+
+    File f = files->open(name, "w");
+    if (!f) return false;
+
+    FixtureBinHeader header = {{'S', 'L', 'F', 'X'}, fixtureBinVersion, 1, 4, 0}; //defaults as in mapInitAlloc
+    f.write((uint8_t *)&header, sizeof(header)); //placeholder, rewritten when size and count are known
+
+    std::vector<FixtureBinPin> pins;
+    uint8_t pin = 0;
+    Coord3D maxPixel = {0, 0, 0};
+    uint32_t nrOfPixels = 0;
+    uint16_t pinLeds = 0;
+    uint16_t block[fixtureBinBlock * 3];
+    uint8_t blockCount = 0;
+    bool ok = true;
+
+    StarJson starJson(fileName);
+    starJson.lookFor("factor", &header.ledFactor);
+    starJson.lookFor("ledFactor", &header.ledFactor); //alias, e.g. misc/F_Panel2x2-16x16.json
+    starJson.lookFor("ledSize", &header.ledSize);
+    starJson.lookFor("shape", &header.ledShape);
+    starJson.lookFor("ledShape", &header.ledShape);
+    starJson.lookFor("pin", &pin);
+    starJson.lookFor("leds", [&](const float *numbers, uint8_t count) {
+      if (count >= 1) {
+        Coord3D pixel = {(int)numbers[0], (count >= 2)?(int)numbers[1]: 0, (count >= 3)?(int)numbers[2]: 0};
+        maxPixel = maxPixel.maximum(pixel);
+        block[blockCount * 3] = pixel.x;
+        block[blockCount * 3 + 1] = pixel.y;
+        block[blockCount * 3 + 2] = pixel.z;
+        if (++blockCount == fixtureBinBlock) {
+          ok = ok && f.write((uint8_t *)block, sizeof(block)) == sizeof(block);
+          blockCount = 0;
+        }
+        nrOfPixels++;
+        pinLeds++;
+      } else { // end of leds array: the pin of this output
+        pins.push_back({pin, 0, pinLeds});
+        pinLeds = 0;
+      }
+    });
+    ok = starJson.deserialize() && ok;
+
+    size_t bytes = blockCount * 3 * sizeof(uint16_t);
+    ok = ok && f.write((uint8_t *)block, bytes) == bytes;
+    bytes = pins.size() * sizeof(FixtureBinPin);
+    ok = ok && f.write((uint8_t *)pins.data(), bytes) == bytes;
+
+    ok = ok && nrOfPixels <= UINT16_MAX && pins.size() <= UINT8_MAX && header.ledFactor > 0;
+    if (ok) {
+      Coord3D size = maxPixel / header.ledFactor + Coord3D{1,1,1}; //as addPixelsPost pass 1
+      header.size[0] = size.x;
+      header.size[1] = size.y;
+      header.size[2] = size.z;
+      header.nrOfLeds = nrOfPixels;
+      header.nrOfPins = pins.size();
+      ok = f.seek(0) && f.write((uint8_t *)&header, sizeof(header)) == sizeof(header);
+    }
+    f.close();
+
+    if (ok) {
+      ppf("fixtureToBin %s -> %s %d pixels %d pins\n", fileName, name, nrOfPixels, pins.size());
+      if (binName) strlcpy(binName, name, binNameSize);
+    } else {
+      ppf("fixtureToBin %s failed\n", fileName);
+      files->remove(name);
+    }
+    files->filesChanged = true;
+    return ok;
+  }
+
   void LedModFixture::loop1s() {
     memmove(tickerTape, tickerTape+1, strlen(tickerTape)); //no memory leak ?
   }
 
   void LedModFixture::mapInitAlloc() {
 
+    #ifdef STARLIGHT_PIPELINE
+      if (outputMutex) xSemaphoreTake(outputMutex, portMAX_DELAY); //the output task waits while drivers and ledsF are set up
+    #endif
+
     mappingStatus = 2; //mapping in progress
+    pixelCacheSize = 0; //refilled in pass 2
+    for (LedsLayer *leds: layers) leds->mapBuilding = false; //a remap in slices is overruled
 
     //init pixels, with some debugging for panels
     // for (int i = 0; i < STARLIGHT_MAXLEDS / 256; i++) //panels
@@ -395,12 +974,15 @@
     //   for (int j=0;j<256;j++)
     //     ledsP[j+i*256]=j < i + 1?CRGB::Red: CRGB::Black; //each panel get as much red pixels as its sequence in the chain
     // }
-    for (int i = 0; i < STARLIGHT_MAXLEDS; i++)
+    for (int i = 0; i < STARLIGHT_MAXLEDS; i++) {
       ledsP[i] = CRGB::Black;
+      ledsF[i] = CRGB::Black; //ledsF == ledsP if no front buffer
+    }
 
     char fileName[32] = "";
+    bool defaultPanel = !files->seqNrToName(fileName, fixtureNr, "F_"); // get the fix->json
 
-    if (files->seqNrToName(fileName, fixtureNr, "F_")) { // get the fix->json
+    if (!defaultPanel) {
       ledFactor = 1; //back to default
       ledSize = 4; //back to default
       ledShape = 0; //back to default
@@ -456,54 +1038,102 @@
       } else 
     #endif
       {
-        start = millis();
-
-        //first pass: find fixSize and nrOfLeds
-        //second pass: create mappings
-        for (pass = 1; pass <=2; pass++)
-        {
-          StarJson starJson(fileName); //open fileName for deserialize
-
-          bool first = true;
-
-          if (pass == 1) { // mappings
-            //what to deserialize
-            starJson.lookFor("factor", &ledFactor);
-            starJson.lookFor("ledSize", &ledSize);
-            starJson.lookFor("shape", &ledShape);
-            starJson.lookFor("pin", &currPin);
-          }
-
-          //lookFor leds array and for each item in array call lambda to make a projection
-          starJson.lookFor("leds", [this, &first](std::vector<uint16_t> uint16CollectList) { //this will be called for each tuple of coordinates!
-
-            if (first) { 
-              addPixelsPre();
-              first = false;
-            }
-
-            if (uint16CollectList.size() >= 1) { // process one pixel
+        uint32_t fixtureHash = fileHash(fileName);
+        if (!mapCacheLoad(fixtureHash)) {
+          start = millis();
 
-              Coord3D pixel;
-              pixel.x = uint16CollectList[0];
-              pixel.y = (uint16CollectList.size() >= 2)?uint16CollectList[1]: 0;
-              pixel.z = (uint16CollectList.size() >= 3)?uint16CollectList[2]: 0;
+          if (strstr(fileName, fixtureBinExt) != nullptr && !mapFixtureBin(fileName)) {
+            //no usable binary fixture: map its json source if still there, otherwise the default panel
+            char *ext = strrchr(fileName, '.');
+            bool fits = ext - fileName + sizeof(".json") <= sizeof(fileName);
+            if (fits) strcpy(ext, ".json");
+            if (fits && LittleFS.exists(fileName))
+              ppf("mapInitAlloc %s instead of the binary fixture\n", fileName);
+            else
+              defaultPanel = true;
+          }
 
-              addPixel(pixel);
-            } //if 1D-3D pixel
-            else { // end of leds array
-              addPin(currPin);
+          if (!defaultPanel && strstr(fileName, fixtureBinExt) == nullptr) { //json
+            //with header metadata (nrOfLeds, width, height and depth before the outputs, see GenFix::closeHeader) in one pass
+            //otherwise first pass: find fixSize and nrOfLeds, second pass: create mappings
+            uint16_t headerLeds = 0, headerWidth = 0, headerHeight = 0, headerDepth = 0;
+            bool useHeader = true;
+            Coord3D maxPixel;
+            fixtureParses = 0;
+            for (pass = 1; pass <=2; pass++)
+            {
+              StarJson starJson(fileName); //open fileName for deserialize
+              fixtureParses++;
+
+              bool first = true;
+              maxPixel = {0, 0, 0};
+
+              if (pass == 1) { // mappings
+                //what to deserialize
+                starJson.lookFor("factor", &ledFactor);
+                starJson.lookFor("ledFactor", &ledFactor); //alias, e.g. misc/F_Panel2x2-16x16.json
+                starJson.lookFor("ledSize", &ledSize);
+                starJson.lookFor("shape", &ledShape);
+                starJson.lookFor("ledShape", &ledShape);
+                starJson.lookFor("nrOfLeds", &headerLeds);
+                starJson.lookFor("width", &headerWidth);
+                starJson.lookFor("height", &headerHeight);
+                starJson.lookFor("depth", &headerDepth);
+              }
+              starJson.lookFor("pin", &currPin); //of each output
+
+              //lookFor leds array and for each item in array call lambda to make a projection
+              starJson.lookFor("leds", [&](const float *numbers, uint8_t count) { //this will be called for each tuple of coordinates!
+
+                if (first) { 
+                  if (pass == 1 && useHeader && headerLeds && headerWidth && headerHeight && headerDepth) { //size and count known: no counting pass
+                    fixSize = {headerWidth, headerHeight, headerDepth};
+                    nrOfLeds = headerLeds;
+                    pass = 2;
+                  }
+                  addPixelsPre();
+                  first = false;
+                }
+
+                if (count >= 1) { // process one pixel
+
+                  Coord3D pixel;
+                  pixel.x = numbers[0];
+                  pixel.y = (count >= 2)?numbers[1]: 0;
+                  pixel.z = (count >= 3)?numbers[2]: 0;
+
+                  maxPixel = maxPixel.maximum(pixel);
+                  addPixel(pixel);
+                } //if 1D-3D pixel
+                else { // end of leds array
+                  addPin(currPin);
+                }
+              }); //starJson.lookFor("leds" (create the right type, otherwise crash)
+
+              bool parsed = starJson.deserialize(); //this will call above function parameter for each led
+
+              //header metadata which does not match the pixels: count them after all, before the layers are mapped (addPixelsPost)
+              if (pass == 2 && useHeader && headerLeds && (indexP != nrOfLeds || maxPixel / ledFactor + Coord3D{1,1,1} != fixSize)) {
+                ppf("dev mapInitAlloc %s header %d leds %d,%d,%d does not match %d leds, count pass\n", fileName, headerLeds, headerWidth, headerHeight, headerDepth, indexP);
+                if (bytesPerPixel && doSendFixtureDefinition && wsBuf) { //preview not sent, the count pass makes a new one
+                  wsBuf->unlock();
+                  web->ws._cleanBuffers();
+                }
+                useHeader = false;
+                pass = 0; //next pass 1
+              } else if (parsed) {
+                addPixelsPost();
+              }
             }
-          }); //starJson.lookFor("leds" (create the right type, otherwise crash)
+          }
+        } //mapCacheLoad
 
-          if (starJson.deserialize()) { //this will call above function parameter for each led
-            addPixelsPost();
-          } // if deserialize
-        }
+        if (!defaultPanel) mapCacheSave(fixtureHash); //also if loaded but layers were mapped again
       }//Live Fixture
     } //if fileName
-    else {
-      ppf("mapInitAlloc: Filename for fixture %d not found show default 16x16 panel\n", fixtureNr);
+
+    if (defaultPanel) {
+      ppf("mapInitAlloc: no fixture %d (%s) show default 16x16 panel\n", fixtureNr, fileName);
 
       //first count then setup
       for (pass = 1; pass <=2; pass++)
@@ -520,6 +1150,10 @@
       }
     }
 
+    #ifdef STARLIGHT_PIPELINE
+      if (outputMutex) xSemaphoreGive(outputMutex);
+    #endif
+
   } //mapInitAlloc
 
 #define headerBytesFixture 16 // so 680 pixels will fit in a PACKAGE_SIZE package ?
@@ -554,6 +1188,17 @@ void LedModFixture::addPixelsPre() {
     indexP = 0;
     prevIndexP = 0; //for allocPins
 
+    //cache the pixels so a remap of layers can run in slices (mapSlice), without the cache remaps are blocking
+    if (nrOfLeds) {
+      size_t bytes = nrOfLeds * 3 * sizeof(uint16_t);
+      uint16_t *newCache = (uint16_t *)(psramFound()?ps_realloc(pixelCache, bytes):realloc(pixelCache, bytes)); // use PSRAM if it exists
+      if (!newCache) {
+        ppf("dev addPixelsPre pixel cache of %d B not allocated, remaps are blocking\n", bytes);
+        free(pixelCache);
+      }
+      pixelCache = newCache;
+    }
+
     if (bytesPerPixel && doSendFixtureDefinition) {
       for (auto &client:web->ws.getClients()) while (client->queueLen() > 3) delay(10); //ui refresh, wait a bit
       size_t len = min(nrOfLeds * 6 + headerBytesFixture, PACKAGE_SIZE);
@@ -624,6 +1269,12 @@ void LedModFixture::addPixel(Coord3D pixel) {
         }
       }
 
+      if (pixelCache && indexP < nrOfLeds) {
+        pixelCache[indexP * 3] = pixel.x;
+        pixelCache[indexP * 3 + 1] = pixel.y;
+        pixelCache[indexP * 3 + 2] = pixel.z;
+      }
+
       uint8_t rowNr = 0;
       for (LedsLayer *leds: layers) {
         leds->addPixel(pixel, rowNr);
@@ -716,23 +1367,18 @@ void LedModFixture::addPixelsPost() {
     mdl->setValue("fixture", "size", fixSize);
     mdl->setValue("fixture", "count", nrOfLeds);
 
-    //init pixelsToBlend
-    for (uint16_t i=0; i<nrOfLeds; i++) {
-      if (pixelsToBlend.size() < nrOfLeds)
-        pixelsToBlend.push_back(false);
-    }
-
     ppf("addPixelsPost(%d) fixture.size = so:%d + l:(%d * %d) B %d ms\n", pass, sizeof(this), STARLIGHT_MAXLEDS, sizeof(CRGB), millis() - start); //56
   }
 
   if (pass == 2) {
     mappingStatus = 0; //not mapping
+    pixelCacheSize = pixelCache && indexP == nrOfLeds?nrOfLeds:0; //complete
 
     //reinit the effect after an effect change causing a mapping change
     uint8_t rowNr = 0;
     for (LedsLayer *leds: layers) {
-      if (eff->doInitEffectRowNr == rowNr) {
-        eff->doInitEffectRowNr = UINT8_MAX;
+      if (leds->doInitEffect) {
+        leds->doInitEffect = false;
         eff->initEffect(*leds, rowNr);
       }
       rowNr++;
@@ -814,10 +1460,10 @@ void LedModFixture::addPixelsPost() {
 
     if (nb_pins > 0) {
       #if CONFIG_IDF_TARGET_ESP32S3 | CONFIG_IDF_TARGET_ESP32S2
-        driver.initled((uint8_t*) ledsP, pins, nb_pins, lengths[0]); //s3 doesn't support lengths so we pick the first
+        driver.initled((uint8_t*) ledsF, pins, nb_pins, lengths[0]); //s3 doesn't support lengths so we pick the first
         //void initled( uint8_t * leds, int * pins, int numstrip, int NUM_LED_PER_STRIP)
       #else
-        driver.initled((uint8_t*) ledsP, pins, lengths, nb_pins, (colorarrangment)colorOrder);
+        driver.initled((uint8_t*) ledsF, pins, lengths, nb_pins, (colorarrangment)colorOrder);
         #if STARLIGHT_LIVE_MAPPING
           driver.setMapLed(&mapLed);
         #endif
@@ -865,7 +1511,7 @@ void LedModFixture::addPixelsPost() {
     }
     ppf("]\n");
 
-    for (int i=0; i< STARLIGHT_MAXLEDS; i++) ledsP[i] = CRGB::Black; //avoid very bright pixels during reboot (WIP)
+    for (int i=0; i< STARLIGHT_MAXLEDS; i++) ledsF[i] = CRGB::Black; //avoid very bright pixels during reboot (WIP)
 
     pinsM->allocatePin(clockPin, "Leds", "Clock");
     pinsM->allocatePin(latchPin, "Leds", "Latch");
@@ -877,14 +1523,14 @@ void LedModFixture::addPixelsPost() {
         driver._clockspeed = clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ;
         driver.setPins(pins, clockPin, latchPin);
       } else
-        driver.initled(ledsP, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size(), clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ);
+        driver.initled(ledsF, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size(), clockFreq==10?clock_1000KHZ:clockFreq==11?clock_1111KHZ:clockFreq==12?clock_1123KHZ:clock_800KHZ);
     #else
       if (driver.driverInit) {
         NUM_LEDS_PER_STRIP = lengths[0]/8; //each shift register feeds 8 panels
         NBIS2SERIALPINS = sortedPins.size();
         driver.setPins(pins, clockPin, latchPin);
       } else
-        driver.initled(ledsP, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size());
+        driver.initled(ledsF, pins, clockPin, latchPin, lengths[0]/8, sortedPins.size());
     #endif
 
     // driver.setColorOrderPerStrip(0, (colorarrangment)colorOrder); //to be implemented...
@@ -929,198 +1575,198 @@ void LedModFixture::addPixelsPost() {
 
       switch (sortedPin.pin) {
       #if CONFIG_IDF_TARGET_ESP32
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !defined(BOARD_HAS_PSRAM) && !defined(ARDUINO_ESP32_PICO)
         // 16+17 = reserved for PSRAM, or reserved for FLASH on pico-D4
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 34-39 input-only
-        // case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32
 
       #if CONFIG_IDF_TARGET_ESP32S2
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !ARDUINO_USB_CDC_ON_BOOT
         // 19 + 20 = USB HWCDC. reserved for USB port when ARDUINO_USB_CDC_ON_BOOT=1
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 22 to 32: not connected, or reserved for SPI FLASH
-        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !defined(BOARD_HAS_PSRAM)
         // 26-32 = reserved for PSRAM
-        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 46 input-only
-        // case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S2
 
       #if CONFIG_IDF_TARGET_ESP32C3
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 11-17 reserved for SPI FLASH
-        //case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        //case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        //case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #if !ARDUINO_USB_CDC_ON_BOOT
         // 18 + 19 = USB HWCDC. reserved for USB port when ARDUINO_USB_CDC_ON_BOOT=1
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
     #endif
         // 20+21 = Serial RX+TX --> don't use for LEDS when serial-to-USB is needed
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S2
 
       #if CONFIG_IDF_TARGET_ESP32S3
-        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 0: FastLED.addLeds<STARLIGHT_CHIPSET, 0>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 1: FastLED.addLeds<STARLIGHT_CHIPSET, 1>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 2: FastLED.addLeds<STARLIGHT_CHIPSET, 2>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 3: FastLED.addLeds<STARLIGHT_CHIPSET, 3>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 4: FastLED.addLeds<STARLIGHT_CHIPSET, 4>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 5: FastLED.addLeds<STARLIGHT_CHIPSET, 5>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 6: FastLED.addLeds<STARLIGHT_CHIPSET, 6>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 7: FastLED.addLeds<STARLIGHT_CHIPSET, 7>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 8: FastLED.addLeds<STARLIGHT_CHIPSET, 8>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 9: FastLED.addLeds<STARLIGHT_CHIPSET, 9>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 10: FastLED.addLeds<STARLIGHT_CHIPSET, 10>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 11: FastLED.addLeds<STARLIGHT_CHIPSET, 11>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 12: FastLED.addLeds<STARLIGHT_CHIPSET, 12>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 13: FastLED.addLeds<STARLIGHT_CHIPSET, 13>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 14: FastLED.addLeds<STARLIGHT_CHIPSET, 14>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 15: FastLED.addLeds<STARLIGHT_CHIPSET, 15>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 16: FastLED.addLeds<STARLIGHT_CHIPSET, 16>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 17: FastLED.addLeds<STARLIGHT_CHIPSET, 17>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 18: FastLED.addLeds<STARLIGHT_CHIPSET, 18>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #if !ARDUINO_USB_CDC_ON_BOOT
         // 19 + 20 = USB-JTAG. Not recommended for other uses.
-        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 19: FastLED.addLeds<STARLIGHT_CHIPSET, 19>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 20: FastLED.addLeds<STARLIGHT_CHIPSET, 20>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif
-        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 21: FastLED.addLeds<STARLIGHT_CHIPSET, 21>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // // 22 to 32: not connected, or SPI FLASH
-        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 22: FastLED.addLeds<STARLIGHT_CHIPSET, 22>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 23: FastLED.addLeds<STARLIGHT_CHIPSET, 23>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 24: FastLED.addLeds<STARLIGHT_CHIPSET, 24>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 25: FastLED.addLeds<STARLIGHT_CHIPSET, 25>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 26: FastLED.addLeds<STARLIGHT_CHIPSET, 26>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 27: FastLED.addLeds<STARLIGHT_CHIPSET, 27>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 28: FastLED.addLeds<STARLIGHT_CHIPSET, 28>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 29: FastLED.addLeds<STARLIGHT_CHIPSET, 29>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 30: FastLED.addLeds<STARLIGHT_CHIPSET, 30>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 31: FastLED.addLeds<STARLIGHT_CHIPSET, 31>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        // case 32: FastLED.addLeds<STARLIGHT_CHIPSET, 32>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #if !defined(BOARD_HAS_PSRAM)
         // 33 to 37: reserved if using _octal_ SPI Flash or _octal_ PSRAM
-        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 33: FastLED.addLeds<STARLIGHT_CHIPSET, 33>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 34: FastLED.addLeds<STARLIGHT_CHIPSET, 34>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 35: FastLED.addLeds<STARLIGHT_CHIPSET, 35>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 36: FastLED.addLeds<STARLIGHT_CHIPSET, 36>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 37: FastLED.addLeds<STARLIGHT_CHIPSET, 37>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif
-        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 38: FastLED.addLeds<STARLIGHT_CHIPSET, 38>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 39: FastLED.addLeds<STARLIGHT_CHIPSET, 39>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 40: FastLED.addLeds<STARLIGHT_CHIPSET, 40>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 41: FastLED.addLeds<STARLIGHT_CHIPSET, 41>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 42: FastLED.addLeds<STARLIGHT_CHIPSET, 42>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
         // 43+44 = Serial RX+TX --> don't use for LEDS when serial-to-USB is needed
-        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 47: FastLED.addLeds<STARLIGHT_CHIPSET, 47>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
-        case 48: FastLED.addLeds<STARLIGHT_CHIPSET, 48>(ledsP, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 43: FastLED.addLeds<STARLIGHT_CHIPSET, 43>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 44: FastLED.addLeds<STARLIGHT_CHIPSET, 44>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 45: FastLED.addLeds<STARLIGHT_CHIPSET, 45>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 46: FastLED.addLeds<STARLIGHT_CHIPSET, 46>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 47: FastLED.addLeds<STARLIGHT_CHIPSET, 47>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
+        case 48: FastLED.addLeds<STARLIGHT_CHIPSET, 48>(ledsF, startLed, nrOfLeds).setCorrection(TypicalLEDStrip); break;
       #endif //CONFIG_IDF_TARGET_ESP32S3
 
       default: ppf("FastLEDPin assignment: pin not supported %d\n", sortedPin.pin);
@@ -14,6 +14,7 @@
 #include "../Sys/SysModModel.h"
 
 #include "LedLayer.h"
+#include <atomic>
 
 #include "FastLED.h"
 
@@ -60,6 +61,47 @@
   static WhateverHubDriver driver;
 #endif
 
+//render and output on different cores: the loop task renders, the output task ships the frames (driver, ArtNet, DDP, preview)
+#if STARLIGHT_PIPELINE && CONFIG_FREERTOS_UNICORE
+  #undef STARLIGHT_PIPELINE //one core only
+#endif
+
+#ifdef STARLIGHT_PIPELINE
+  #define frameQueueLength 2 //frames waiting for the output task
+
+  //lock free single producer (loop task) single consumer (output task) queue of complete frames
+  //  head is only written by the producer, tail only by the consumer
+  struct FrameQueue {
+    CRGB *slots[frameQueueLength] = {}; //nullptr if not allocated
+    uint16_t nrOfLeds[frameQueueLength] = {};
+    std::atomic<uint8_t> head{0};
+    std::atomic<uint8_t> tail{0};
+
+    uint8_t depth() const {
+      return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool full() const {return depth() >= frameQueueLength;}
+
+    bool push(const CRGB *frame, uint16_t nrOfLeds) {
+      uint8_t h = head.load(std::memory_order_relaxed);
+      if ((uint8_t)(h - tail.load(std::memory_order_acquire)) >= frameQueueLength) return false;
+      memcpy(slots[h % frameQueueLength], frame, nrOfLeds * sizeof(CRGB));
+      this->nrOfLeds[h % frameQueueLength] = nrOfLeds;
+      head.store(h + 1, std::memory_order_release); //publish the slot
+      return true;
+    }
+
+    bool pop(CRGB *frame) {
+      uint8_t t = tail.load(std::memory_order_relaxed);
+      if (head.load(std::memory_order_acquire) == t) return false;
+      memcpy(frame, slots[t % frameQueueLength], nrOfLeds[t % frameQueueLength] * sizeof(CRGB));
+      tail.store(t + 1, std::memory_order_release); //free the slot
+      return true;
+    }
+  };
+#endif
+
 struct SortedPin {
   uint16_t startLed;
   uint16_t nrOfLeds;
@@ -70,7 +112,36 @@ class LedModFixture: public SysModule {
 
 public:
 
-  CRGB ledsP[STARLIGHT_MAXLEDS];
+  CRGB ledsP[STARLIGHT_MAXLEDS]; //the layers render here (back buffer)
+
+  //front buffer: the outputs (driver, ArtNet, DDP, preview) read the last complete frame, handed over by frameReady
+  //  so rendering the next frame in ledsP does not change what is shipped, ledsF is ledsP if there is no memory for it
+  CRGB *ledsF = ledsP;
+  uint32_t frameNr = 0; //frames handed over
+  void frameReady();
+
+  bool pipelined() const {
+    #ifdef STARLIGHT_PIPELINE
+      return outputTaskHandle != nullptr;
+    #else
+      return false;
+    #endif
+  }
+
+  #ifdef STARLIGHT_PIPELINE
+    FrameQueue frameQueue;
+    std::vector<std::function<void()>> frameOutputs; //network outputs (ArtNet, DDP) the output task calls after each driver show
+    TaskHandle_t outputTaskHandle = nullptr;
+    SemaphoreHandle_t outputMutex = nullptr; //held by the output task per frame and by mapInitAlloc (drivers and ledsF change)
+    std::atomic<bool> previewRequested{false}; //preview onLoop asks the output task to send the next frame
+    uint16_t outputFps = 0;
+    uint16_t outputFrameCounter = 0;
+    uint16_t droppedFrameCounter = 0; //queue full
+    uint8_t maxQueueDepth = 0;
+    static void outputTask(void *parameter);
+    void addFrameOutput(std::function<void()> frameOutput);
+  #endif
+  void previewSend();
 
   // CRGB *leds = nullptr;
     // if (!leds)
@@ -81,15 +152,7 @@ public:
   // leds = (CRGB*)malloc(nrOfLeds * sizeof(CRGB));
   // leds = (CRGB*)reallocarray
 
-  std::vector<bool> pixelsToBlend; //this is a 1-bit vector !!! overlapping effects will blend
   LedModFixture() :SysModule("Fixture") {
-    //init pixelsToBlend
-    for (uint16_t i=0; i<nrOfLeds; i++) {
-      if (pixelsToBlend.size() < nrOfLeds)
-        pixelsToBlend.push_back(false);
-    }
-    ppf("Fixture constructor ptb:%d\n", pixelsToBlend.size());
-
     #ifdef STARLIGHT_PHYSICAL_DRIVER
       //'hack' to make sure show is not called before init
       #if !(CONFIG_IDF_TARGET_ESP32S3 || CONFIG_IDF_TARGET_ESP32S2)
@@ -138,12 +201,10 @@ public:
 
   Coord3D head = {0,0,0};
 
-  uint8_t mappingStatus = 0; //not mapping
+  std::atomic<uint8_t> mappingStatus{0}; //0: not mapping, 1: mapping requested, 2: mapping (blocking), 3: mapping in slices (rendering continues). Atomic: read by the output task on the other core
   bool doAllocPins = false;
   bool doSendFixtureDefinition = false;
 
-  uint8_t globalBlend = 128;
-
   uint16_t fps = 200;
   uint16_t realFps = 200;
   bool3State showTicker = false;
@@ -158,6 +219,26 @@ public:
 
   void mapInitAlloc();
 
+  //remap of layers without a fixture change: built in slices from the cached pixels into the layers shadow mapping
+  uint16_t *pixelCache = nullptr; //x,y,z of each pixel as in the fixture, filled by addPixel in pass 2
+  uint16_t pixelCacheSize = 0; //nr of pixels cached, 0 if not complete
+  uint16_t mapSliceIndexP = 0; //next pixel to map
+  bool mapSlicesStart();
+  bool mapSlice(); //true if the new mappings are live
+
+  //mapping cache: a blocking mapping saves the fixture (size, pins, pixels) and the mapping of each layer,
+  //  the next blocking mapping of the same fixture file restores it without parsing, layers with the same mappingKey get their tables back
+  #define mapCacheFile "/mapcache.bin"
+  uint32_t mapCacheSignature = 0; //fixture hash and layer keys of the saved cache, no flash writes if unchanged
+  bool mapCacheLoad(uint32_t fixtureHash);
+  void mapCacheSave(uint32_t fixtureHash);
+
+  //binary fixture F_*.bin: header (size, count, pins), pixels (x,y,z uint16) and pins, read in blocks without a counting pass
+  #define fixtureBinExt ".bin"
+  bool mapFixtureBin(const char *fileName); //false if no valid header or pins: nothing mapped
+  bool fixtureToBin(const char *fileName, char *binName = nullptr, size_t binNameSize = 0); //F_*.json to F_*.bin
+  uint8_t fixtureParses = 0; //of the last json fixture mapped: 1 with matching header metadata, 2 without, 3 if the header does not match
+
   //load fixture json file, parse it and depending on the projection, create a mapping for it
   uint16_t previewBufferIndex = 0;
   unsigned long start = millis();
@@ -10,8 +10,11 @@
 */
 
 //GenFix: class to provide fixture write functions and save to json file
+//  written in one pass through a buffer, the header (with nrOfLeds and size) is rewritten in place when closed
+#define genFixBufferSize 1024
 // {
 //   "name": "F_Hexagon",
+//   "factor": 10, "ledSize": 5, "shape": 0,
 //   "nrOfLeds": 216,
 //   "width": 6554,
 //   "height": 6554,
@@ -34,6 +37,14 @@ public:
   
   File f;
 
+  //header metadata: the loader maps in one pass if it knows size and count before the outputs
+  uint16_t nrOfLeds = 0;
+  Coord3D maxPixel = {0, 0, 0};
+
+  //pixels are formatted in a buffer written to the fixture file when full
+  char buffer[genFixBufferSize];
+  size_t bufferLength = 0;
+
   GenFix() {
     ppf("GenFix constructor\n");
   }
@@ -50,57 +61,72 @@ public:
 
     va_end(args);
 
-    f = files->open("/temp.json", FILE_WRITE);
+    char fileName[32] = "/";
+    print->fFormat(fileName, sizeof(fileName), "/%s.json", name);
+
+    f = files->open(fileName, FILE_WRITE);
     if (!f)
-      ppf("GenFix could not open temp file for writing\n");
+      ppf("GenFix could not open %s for writing\n", fileName);
+
+    bufferLength = 0;
+    nrOfLeds = 0;
+    maxPixel = {0, 0, 0};
+    writeHeader(); //placeholder, rewritten by closeHeader when size and count are known
 
-    f.print(",\"outputs\":[");
+    add(",\"outputs\":[");
     strlcpy(pinSep, "", sizeof(pinSep));
   }
 
   void closeHeader() {
-    f.print("]"); //outputs
+    add("]}"); //outputs
+    flush();
 
-    ppf("closeHeader\n");
+    ppf("closeHeader %d leds\n", nrOfLeds);
+    f.seek(0);
+    writeHeader();
     f.close();
-    f = files->open("/temp.json", FILE_READ);
-
-    File g;
-
-    char fileName[32] = "/";
-    print->fFormat(fileName, sizeof(fileName), "/%s.json", name);
-
-    //create g by merging in f (better solution?)
-    g = files->open(fileName, FILE_WRITE);
+  }
 
-    g.print("{");
-    g.printf("\"name\":\"%s\"", name);
-    g.printf(",\"factor\":%d", factor);
-    g.printf(",\"ledSize\":%d", ledSize);
-    g.printf(",\"shape\":%d", shape);
+  //fixed width values so the header can be rewritten in place
+  void writeHeader() {
+    Coord3D size = maxPixel / factor + Coord3D{1,1,1}; //as LedModFixture::addPixelsPost pass 1
+    f.printf("{\"name\":\"%s\",\"factor\":%3d,\"ledSize\":%5d,\"shape\":%3d,\"nrOfLeds\":%5d,\"width\":%5d,\"height\":%5d,\"depth\":%5d",
+      name, factor, ledSize, shape, nrOfLeds, size.x, size.y, size.z);
+  }
 
-    byte character;
-    f.read(&character, sizeof(byte));
-    while (f.available()) {
-      g.write(character);
-      f.read(&character, sizeof(byte));
+  void add(const char *text) {
+    for (; *text; text++) {
+      if (bufferLength == sizeof(buffer)) flush();
+      buffer[bufferLength++] = *text;
     }
-    g.write(character);
+  }
 
-    g.print("}");
-    g.close();
-    f.close();
+  void add(uint16_t number) {
+    char digits[6];
+    uint8_t length = 0;
+    do {
+      digits[length++] = '0' + number % 10;
+      number /= 10;
+    } while (number);
+    if (bufferLength + length > sizeof(buffer)) flush();
+    while (length) buffer[bufferLength++] = digits[--length];
+  }
 
-    files->remove("/temp.json");
+  void flush() {
+    if (bufferLength) f.write((uint8_t *)buffer, bufferLength);
+    bufferLength = 0;
   }
 
   void openPin(uint8_t pin) {
-    f.printf("%s{\"pin\":%d,\"leds\":[", pinSep, pin);
+    add(pinSep);
+    add("{\"pin\":");
+    add(pin);
+    add(",\"leds\":[");
     strlcpy(pinSep, ",", sizeof(pinSep));
     strlcpy(pixelSep, "", sizeof(pixelSep));
   }
   void closePin() {
-    f.printf("]}");
+    add("]}");
   }
 
   void write3D(Coord3D pixel) {
@@ -113,8 +139,17 @@ public:
       ppf("write3D coord too high %d,%d,%d\n", x, y, z);
     else
     {
-      f.printf("%s[%d,%d,%d]", pixelSep, x, y, z);
+      add(pixelSep);
+      add("[");
+      add(x);
+      add(",");
+      add(y);
+      add(",");
+      add(z);
+      add("]");
       strlcpy(pixelSep, ",", sizeof(pixelSep));
+      nrOfLeds++;
+      maxPixel = maxPixel.maximum({x, y, z});
     }
 
   }
@@ -609,6 +644,7 @@ public:
 
     //remove all the variables
     fixtureVar.remove("n"); //tbd: we should also remove the varEvent !!
+    mdl->varsRemoved();
 
     //part 0: group variables
     if (strncmp(fgGroup, "Matrices", 9) == 0 || strncmp(fgGroup, "Cubes", 6) == 0) {
@@ -355,20 +355,27 @@ class TiltPanRollProjection: public Projection {
     pixel.z += offset.z;
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+  //tilt, pan and roll around the middle, in one matrix per frame (period 255)
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
+    transform.identity();
+    transform.pre = leds.size/2;
+    transform.post = leds.size/2;
     #ifdef STARBASE_USERMOD_MPU6050
       if (leds.proGyro) {
-        pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, mpu6050->gyro.x);
-        pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, mpu6050->gyro.y);
-        pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, mpu6050->gyro.z);
+        transform.rotate(0, mpu6050->gyro.x, 255);
+        transform.rotate(1, mpu6050->gyro.y, 255);
+        transform.rotate(2, mpu6050->gyro.z, 255);
       }
       else 
     #endif
     {
-      if (leds.proTiltSpeed) pixel = trigoTiltPanRoll.tilt(pixel, leds.size/2, sys->now * 5 / (255 - leds.proTiltSpeed));
-      if (leds.proPanSpeed) pixel = trigoTiltPanRoll.pan(pixel, leds.size/2, sys->now * 5 / (255 - leds.proPanSpeed));
-      if (leds.proRollSpeed) pixel = trigoTiltPanRoll.roll(pixel, leds.size/2, sys->now * 5 / (255 - leds.proRollSpeed));
-      if (fix->fixSize.z == 1) pixel.z = 0; // 3d effects will be flattened on 2D fixtures
+      if (leds.proTiltSpeed) transform.rotate(0, sys->now * 5 / (255 - leds.proTiltSpeed), 255);
+      if (leds.proPanSpeed) transform.rotate(1, sys->now * 5 / (255 - leds.proPanSpeed), 255);
+      if (leds.proRollSpeed) transform.rotate(2, sys->now * 5 / (255 - leds.proRollSpeed), 255);
+      if (fix->fixSize.z == 1) { // 3d effects will be flattened on 2D fixtures
+        transform.m[2][0] = transform.m[2][1] = transform.m[2][2] = 0;
+        transform.post.z = 0;
+      }
     }
   }
 }; //TiltPanRollProjection
@@ -459,9 +466,9 @@ class Preset1Projection: public Projection {
     dp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
     TiltPanRollProjection tp;
-    tp.XYZ(leds, pixel);
+    tp.frameTransform(leds, transform);
   }
 }; //Preset1Projection
 
@@ -472,6 +479,10 @@ class RandomProjection: public Projection {
   void setup(LedsLayer &leds, Variable parentVar) override {
   }
 
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
+    transform.type = t_perPixel; //another random pixel each call
+  }
+
   void XYZ(LedsLayer &leds, Coord3D &pixel) override {
     pixel = Coord3D({random(leds.size.x), random(leds.size.y), random(leds.size.z)})  ;
   }
@@ -630,6 +641,7 @@ class MirrorProjection: public Projection {
     bool3State *mirrorX = leds.projectionData.write<bool3State>(false);
     bool3State *mirrorY = leds.projectionData.write<bool3State>(false);
     bool3State *mirrorZ = leds.projectionData.write<bool3State>(false);
+    leds.projectionData.readWrite<Coord3D>(); //originalSize, set in addPixelsPre (so projections using Mirror can add their data after it)
     ui->initCheckBox(parentVar, "mirrorX", mirrorX, false, [&leds](EventArguments) { switch (eventType) {
       case onChange:
         leds.triggerMapping();
@@ -880,18 +892,21 @@ class ScrollingProjection: public Projection {
     mp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
     bool3State mirrorX = leds.projectionData.read<bool3State>(); // Not used 
     bool3State mirrorY = leds.projectionData.read<bool3State>(); // Not used
     bool3State mirrorZ = leds.projectionData.read<bool3State>(); // Not used
+    Coord3D originalSize = leds.projectionData.read<Coord3D>(); // Not used
 
     uint8_t xSpeed = leds.projectionData.read<uint8_t>();
     uint8_t ySpeed = leds.projectionData.read<uint8_t>();
     uint8_t zSpeed = leds.projectionData.read<uint8_t>();
 
-    if (xSpeed) pixel.x = (pixel.x + (sys->now * xSpeed / 255 / 100)) % leds.size.x;
-    if (ySpeed) pixel.y = (pixel.y + (sys->now * ySpeed / 255 / 100)) % leds.size.y;
-    if (zSpeed) pixel.z = (pixel.z + (sys->now * zSpeed / 255 / 100)) % leds.size.z;
+    //offset this frame, wrapped around
+    transform.identity();
+    if (xSpeed) {transform.post.x = (sys->now * xSpeed / 255 / 100) % leds.size.x; transform.bounds[0] = tb_wrap;}
+    if (ySpeed) {transform.post.y = (sys->now * ySpeed / 255 / 100) % leds.size.y; transform.bounds[1] = tb_wrap;}
+    if (zSpeed) {transform.post.z = (sys->now * zSpeed / 255 / 100) % leds.size.z; transform.bounds[2] = tb_wrap;}
   }
 }; //ScrollingProjection
 
@@ -918,7 +933,7 @@ class AccelerationProjection: public Projection {
     dp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
     bool3State wrap = leds.projectionData.read<bool3State>();
     float sensitivity = float(leds.projectionData.read<uint8_t>()) / 20.0 + 1; // 0 - 100 slider -> 1.0 - 6.0 multiplier 
     uint16_t deadzone = map(leds.projectionData.read<uint8_t>(), 0, 255, 0 , 1000); // 0 - 1000
@@ -932,14 +947,12 @@ class AccelerationProjection: public Projection {
     int xMove = map(accelX, -32768, 32767, -leds.size.x, leds.size.x) * sensitivity;
     int yMove = map(accelY, -32768, 32767, -leds.size.y, leds.size.y) * sensitivity;
 
-    // if (pixel.x == 0 && pixel.y == 0) ppf("Accel: %d %d xMove: %d yMove: %d\n", accelX, accelY, xMove, yMove);
+    // ppf("Accel: %d %d xMove: %d yMove: %d\n", accelX, accelY, xMove, yMove);
   
-    pixel.x += xMove;
-    pixel.y += yMove;
-    if (wrap) {
-      pixel.x %= leds.size.x;
-      pixel.y %= leds.size.y;
-    }
+    transform.identity();
+    transform.post.x = xMove;
+    transform.post.y = yMove;
+    if (wrap) transform.bounds[0] = transform.bounds[1] = tb_wrap;
   }
 }; //Acceleration
 
@@ -1009,10 +1022,9 @@ class RotateProjection: public Projection {
   const char * name() override {return "Rotate";}
   const char * tags() override {return "💫";}
 
-  struct RotateData { // 16 bytes
+  struct RotateData { // 12 bytes
     union {
       struct {
-        bool flip : 1;
         bool reverse : 1;
         bool alternate : 1;
         bool expand : 1; 
@@ -1024,8 +1036,6 @@ class RotateProjection: public Projection {
     uint8_t  midY;
     uint16_t angle;
     uint16_t interval; // ms between updates
-    int16_t  shearX;
-    int16_t  shearY;
     unsigned long lastUpdate; // last sys->now update
   };
 
@@ -1097,57 +1107,24 @@ class RotateProjection: public Projection {
     dp.addPixel(leds, pixel);
   }
 
-  void XYZ(LedsLayer &leds, Coord3D &pixel) override {
+  void frameTransform(LedsLayer &leds, PixelTransform &transform) override {
     RotateData *data = leds.projectionData.readWrite<RotateData>();
 
-    constexpr int Fixed_Scale = 1 << 10;
-
     if ((sys->now - data->lastUpdate > data->interval) && data->speed) { // Only update if the angle has changed
       data->lastUpdate = sys->now;
       // Increment the angle
       data->angle = data->reverse ? (data->angle <= 0 ? 359 : data->angle - 1) : (data->angle >= 359 ? 0 : data->angle + 1);
       
       if (data->alternate && (data->angle == 0)) data->reverse = !data->reverse;
-
-      data->flip = (data->angle > 90 && data->angle < 270);
-
-      int newAngle = data->angle; // Flip newAngle if needed. Don't change angle in data
-      if (data->flip) {newAngle += 180; newAngle %= 360;}
-
-      // Calculate shearX and shearY
-      float angleRadians = radians(newAngle);
-      data->shearX = -tan(angleRadians / 2) * Fixed_Scale;
-      data->shearY =  sin(angleRadians)     * Fixed_Scale;
-    }
-
-    int maxX = leds.size.x;
-    int maxY = leds.size.y;
-
-    if (data->flip) {
-      // Reverse x and y values
-      pixel.x = maxX - pixel.x;
-      pixel.y = maxY - pixel.y;
     }
 
-    // Translate pixel to origin
-    int dx = pixel.x - data->midX;
-    int dy = pixel.y - data->midY;
-
-    // Apply the 3 shear transformations
-    int x1 = dx + data->shearX * dy / Fixed_Scale;
-    int y1 = dy + data->shearY * x1 / Fixed_Scale;
-    int x2 = x1 + data->shearX * y1 / Fixed_Scale;
-
-    // Translate pixel back and assign
-    pixel.x = x2 + data->midX;
-    pixel.y = y1 + data->midY;
-    pixel.z = 0;
-
-    // Clamp the pixel to the bounds
-    if      (pixel.x < 0)     pixel.x = 0;
-    else if (pixel.x >= maxX) pixel.x = maxX - 1;
-    if      (pixel.y < 0)     pixel.y = 0;
-    else if (pixel.y >= maxY) pixel.y = maxY - 1;
+    // Rotate around the middle in one matrix (was 3 shears per pixel), flattened and clamped to the bounds
+    transform.identity();
+    transform.pre = {data->midX, data->midY, 0};
+    transform.post = {data->midX, data->midY, 0};
+    transform.rotate(2, data->angle);
+    transform.m[2][2] = 0;
+    transform.bounds[0] = transform.bounds[1] = tb_clamp;
   }
 }; //RotateProjection
 
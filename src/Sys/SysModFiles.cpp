@@ -78,7 +78,7 @@ void SysModFiles::setup() {
 
   ui->initProgress(parentVar, "totalSize", 0, 0, files->totalBytes(), true, [](EventArguments) { switch (eventType) {
     case onChange:
-      variable.var["max"] = files->totalBytes(); //makes sense?
+      variable.maxValue(files->totalBytes()); //makes sense?
       web->addResponse(variable.var, "comment", "%d / %d B", files->usedBytes(), files->totalBytes());
       return true;
     default: return false;
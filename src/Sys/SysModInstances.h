@@ -229,7 +229,7 @@ public:
       print->fFormat(columnVarID, sizeof(columnVarID), "ins%s_%s", variable.pid(), variable.id());
 
       //create a var of the same type. InitVar is not calling onChange which is good in this situation!  // = ui->cloneVar(var, columnVarID, [this, var](JsonObject insVar){});
-      Variable insVariable = mdl->initVar(tableVar, columnVarID, variable.var["type"], false, [this](Variable insVariable, uint8_t rowNr, uint8_t eventType) {
+      Variable insVariable = mdl->initVar(tableVar, columnVarID, variable.type(), false, [this](Variable insVariable, uint8_t rowNr, uint8_t eventType) {
         //extract the variable from insVariable.id()
         char pid[32]; strlcpy(pid, insVariable.id() + 3, sizeof(pid)); //+3 : remove ins
         char * id = strtok(pid, "_"); if (id != nullptr ) {strlcpy(pid, id, sizeof(pid)); id = strtok(nullptr, "_");} //split pid and id
@@ -271,8 +271,8 @@ public:
       }});
 
       if (insVariable.var) {
-        if (!variable.var["min"].isNull()) insVariable.var["min"] = variable.var["min"];
-        if (!variable.var["max"].isNull()) insVariable.var["max"] = variable.var["max"];
+        if (variable.minValue()) insVariable.minValue(variable.minValue());
+        if (variable.maxValue()) insVariable.maxValue(variable.maxValue());
         if (!variable.var["log"].isNull()) insVariable.var["log"] = variable.var["log"];
         // insVar["fun"] = var["fun"]; //copy the onUI
       }
@@ -14,7 +14,9 @@
 #include "SysModFiles.h"
 #include "SysStarJson.h"
 #include "SysModUI.h"
-#include "SysModInstances.h"
+#ifndef STARBASE_NATIVE
+  #include "SysModInstances.h"
+#endif
 
   Variable::Variable() {
     var = JsonObject(); //undefined variable
@@ -45,6 +47,7 @@
       JsonArray valArray = childVariable.valArray();
       if (!valArray.isNull()) {
         valArray.remove(rowNr);
+        mdl->varChanged(childVariable); //for the journal: the column without the row
         //recursive
         childVariable.removeValuesForRow(rowNr);
       }
@@ -81,6 +84,7 @@
       }
     else {
       var["n"].to<JsonArray>(); //delete old values
+      mdl->varsRemoved();
     }
 
     ppf("preDetails %s.%s post ", pid(), id());
@@ -118,6 +122,7 @@
             if (allNull) {
               ppf("remove allnulls %s\n", childVariable.id());
               children().remove(childVarIt);
+              mdl->varsRemoved();
             }
           }
           else
@@ -128,6 +133,7 @@
             ppf("varPostDetails %s.%s <- null\n", id(), childVariable.id());
             print->printJson("remove", childVar);
             children().remove(childVarIt);
+            mdl->varsRemoved();
           }
         }
 
@@ -141,108 +147,101 @@
     if (rowNr != UINT8_MAX)
       web->getResponseObject()["details"]["rowNr"] = rowNr;
     web->getResponseObject()["details"]["var"] = var;
+    mdl->addVarMetaJson(web->getResponseObject()["details"]["var"]); //the copy for the ui
   }
 
-  bool Variable::triggerEvent(uint8_t eventType, uint8_t rowNr, bool init) {
+  void Variable::writePointer(uint8_t rowNr) {
+    VarMeta *varMeta = meta();
+    if (!varMeta || (!varMeta->pointer && !varMeta->rowPointers.size())) return;
+    JsonVariant value;
+    if (rowNr == UINT8_MAX) {
+      value = this->value(); 
+    } else {
+      value = this->value(rowNr);
+    }
 
-    if (eventType == onChange) {
-      if (!init) {
-        if (!var["dash"].isNull())
-          instances->changedVarsQueue.push_back(var); //tbd: check value arrays / rowNr is working
-      }
+    //pointer is an array if set by setValueRowNr, used for controls as each control has a seperate variable
+    bool isPointerArray = varMeta->rowPointers.size();
+    intptr_t pointer = !isPointerArray?varMeta->pointer: rowNr < varMeta->rowPointers.size()?varMeta->rowPointers[rowNr]:0;
 
-      //if var is bound by pointer, set the pointer value before calling onChange
-      if (!var["p"].isNull()) {
-        JsonVariant value;
-        if (rowNr == UINT8_MAX) {
-          value = this->value(); 
-        } else {
-          value = this->value(rowNr);
+    if (pointer != 0) {
+
+      if (this->value().is<JsonArray>() && !isPointerArray) { //vector if val array but not if control (each var in array stored in seperate variable)
+        if (rowNr != UINT8_MAX) {
+          //pointer checks
+          switch (varMeta->type) {
+          case vm_uint8: {
+            std::vector<uint8_t> *valuePointer = (std::vector<uint8_t> *)pointer;
+            while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT8_MAX); //create vector space if needed...
+            ppf("%s.%s[%d]:%s (%d - %d)\n", pid(), id(), rowNr, valueString().c_str(), pointer, (*valuePointer).size());
+            (*valuePointer)[rowNr] = value;
+            break; }
+          case vm_uint16: {
+            std::vector<uint16_t> *valuePointer = (std::vector<uint16_t> *)pointer;
+            while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT16_MAX); //create vector space if needed...
+            (*valuePointer)[rowNr] = value;
+            break; }
+          case vm_bool3State: {
+            std::vector<bool3State> *valuePointer = (std::vector<bool3State> *)pointer;
+            while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT8_MAX); //create vector space if needed...
+            (*valuePointer)[rowNr] = value;
+            break; }
+          case vm_text: {
+            std::vector<VectorString> *valuePointer = (std::vector<VectorString> *)pointer;
+            while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(VectorString()); //create vector space if needed...
+            strlcpy((*valuePointer)[rowNr].s, value.as<const char *>(), sizeof(VectorString().s));
+            break; }
+          case vm_coord3D: {
+            std::vector<Coord3D> *valuePointer = (std::vector<Coord3D> *)pointer;
+            while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back({-1,-1,-1}); //create vector space if needed...
+            (*valuePointer)[rowNr] = value;
+            break; }
+          default:
+            print->printJson("dev triggerChange type not supported yet (arrays)", var);
+          }
+
+          // ppf("triggerChange set pointer to vector %s[%d]: v:%s p:%d\n", id(), rowNr, value.as<String>().c_str(), pointer);
+        } else 
+          print->printJson("dev value is array but no rowNr\n", var);
+      } else { //no array
+        //pointer checks
+        switch (varMeta->type) {
+        case vm_uint8:
+          *(uint8_t *)pointer = value;
+          break;
+        case vm_uint16:
+          *(uint16_t *)pointer = value;
+          break;
+        case vm_bool3State:
+          *(bool3State *)pointer = value;
+          break;
+        case vm_coord3D:
+          *(Coord3D *)pointer = value;
+          break;
+        default:
+          print->printJson("dev triggerChange type not supported yet", var);
         }
 
-        //pointer is an array if set by setValueRowNr, used for controls as each control has a seperate variable
-        bool isPointerArray = var["p"].is<JsonArray>();
-        int pointer;
-        if (isPointerArray)
-          pointer = var["p"][rowNr];
-        else
-          pointer = var["p"];
+        // ppf("triggerChange set pointer %s[%d]: v:%s p:%d\n", id(), rowNr, valueString().c_str(), pointer);
+      }
+    }
+    else
+      print->printJson("dev pointer is 0", var);
+  }
 
-        if (pointer != 0) {
+  bool Variable::triggerEvent(uint8_t eventType, uint8_t rowNr, bool init) {
 
-          if (this->value().is<JsonArray>() && !isPointerArray) { //vector if val array but not if control (each var in array stored in seperate variable)
-            if (rowNr != UINT8_MAX) {
-              //pointer checks
-              if (var["type"] == "select" || var["type"] == "range" || var["type"] == "pin") {
-                std::vector<uint8_t> *valuePointer = (std::vector<uint8_t> *)pointer;
-                while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT8_MAX); //create vector space if needed...
-                ppf("%s.%s[%d]:%s (%d - %d - %s)\n", pid(), id(), rowNr, valueString().c_str(), pointer, (*valuePointer).size(), var["p"].as<String>().c_str());
-                (*valuePointer)[rowNr] = value;
-              }
-              else if (var["type"] == "number") {
-                std::vector<uint16_t> *valuePointer = (std::vector<uint16_t> *)pointer;
-                while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT16_MAX); //create vector space if needed...
-                (*valuePointer)[rowNr] = value;
-              }
-              else if (var["type"] == "checkbox") {
-                std::vector<bool3State> *valuePointer = (std::vector<bool3State> *)pointer;
-                while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(UINT8_MAX); //create vector space if needed...
-                (*valuePointer)[rowNr] = value;
-              }
-              else if (var["type"] == "text" || var["type"] == "fileEdit") {
-                std::vector<VectorString> *valuePointer = (std::vector<VectorString> *)pointer;
-                while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back(VectorString()); //create vector space if needed...
-                strlcpy((*valuePointer)[rowNr].s, value.as<const char *>(), sizeof(VectorString().s));
-              }
-              else if (var["type"] == "coord3D") {
-                std::vector<Coord3D> *valuePointer = (std::vector<Coord3D> *)pointer;
-                while (rowNr >= (*valuePointer).size()) (*valuePointer).push_back({-1,-1,-1}); //create vector space if needed...
-                (*valuePointer)[rowNr] = value;
-              }
-              else
-                print->printJson("dev triggerChange type not supported yet (arrays)", var);
-
-              // ppf("triggerChange set pointer to vector %s[%d]: v:%s p:%d\n", id(), rowNr, value.as<String>().c_str(), pointer);
-            } else 
-              print->printJson("dev value is array but no rowNr\n", var);
-          } else { //no array
-            //pointer checks
-            if (var["type"] == "select" || var["type"] == "range" || var["type"] == "pin") {
-              uint8_t *valuePointer = (uint8_t *)pointer;
-              *valuePointer = value;
-            }
-            else if (var["type"] == "number") {
-              uint16_t *valuePointer = (uint16_t *)pointer;
-              *valuePointer = value;
-            }
-            else if (var["type"] == "checkbox") {
-              bool3State *valuePointer = (bool3State *)pointer;
-              *valuePointer = value;
-            }
-            else if (var["type"] == "coord3D") {
-              Coord3D *valuePointer = (Coord3D *)pointer;
-              *valuePointer = value;
-            }
-            else
-              print->printJson("dev triggerChange type not supported yet", var);
+    if (eventType == onChange) {
+      if (!init && !readOnly() && !isType("button")) mdl->varChanged(*this); //for the journal
 
-            // ppf("triggerChange set pointer %s[%d]: v:%s p:%d\n", id(), rowNr, valueString().c_str(), pointer);
-          }
+      #ifndef STARBASE_NATIVE //no instances on the host
+      if (!init) {
+        if (!var["dash"].isNull())
+          instances->changedVarsQueue.push_back(var); //tbd: check value arrays / rowNr is working
+      }
+      #endif
 
-          // else if (var["type"] == "text") {
-          //   const char *valuePointer = (const char *)pointer;
-          //   if (valuePointer != nullptr) {
-          //     *valuePointer = value;
-          //     ppf("pointer set16 %s: v:%d (p:%p) (r:%d v:%s p:%d)\n", id(), *valuePointer, valuePointer, rowNr, valueString().c_str(), pointer);
-          //   }
-          //   else
-          //     ppf("dev pointer set16 %s: v:%d (p:%p) (r:%d v:%s p:%d)\n", id(), *valuePointer, valuePointer, rowNr, valueString().c_str(), pointer);
-          // }
-        }
-        else
-          // ppf("dev pointer of type %s is 0\n", var["type"].as<String>().c_str());
-          print->printJson("dev pointer is 0", var);
-      } //pointer
+      writePointer(rowNr); //if var is bound by pointer, set the pointer value before calling onChange
 
       //reset presets if not using presets controls and if updated by UI, except if updated by ui via presets
       if (var["id"] != "preset" && var["id"] != "assignPreset" && var["id"] != "clearPreset" && mdl->resetPresetThreshold > 1) {
@@ -259,6 +258,8 @@
 
     //call varEvent if exists
     if (!var["fun"].isNull()) { //isNull needed here!
+      bool loopTask = mdl->onLoopTask();
+      if (loopTask) mdl->syncDepth++; //setValue in events is synchronous
       size_t funNr = var["fun"];
       if (funNr < mdl->varEvents.size()) {
         // ppf("voor v1 call %s.%s[%d] %d %d %d\n", pid(), id(), rowNr, funNr, eventType, mdl->varEvents.size());
@@ -287,6 +288,7 @@
         result = publish(eventType, rowNr);
       else
         ppf("dev triggerEvent function nr %s.%s outside bounds %d >= %d\n", pid(), id(), funNr, mdl->varEvents.size());
+      if (loopTask) mdl->syncDepth--;
     } //varEvent exists
 
 
@@ -298,40 +300,44 @@
       //find the columns of the table
       if (eventType == onDelete) {
         for (JsonObject childVar: children()) {
-          int pointer;
-          if (childVar["p"].is<JsonArray>())
-            pointer = childVar["p"][rowNr];
-          else
-            pointer = childVar["p"];
+          Variable childVariable = Variable(childVar);
+          VarMeta *childMeta = childVariable.meta();
+          intptr_t pointer = childVariable.pointer(rowNr);
 
-          ppf("  delete vector %s[%d] %d\n", Variable(childVar).id(), rowNr, pointer);
+          ppf("  delete vector %s[%d] %d\n", childVariable.id(), rowNr, pointer);
 
           if (pointer != 0) {
             //pointer checks
             // check rowNr as it can be 255 
-            if (childVar["type"] == "select" || childVar["type"] == "range" || childVar["type"] == "pin") {
+            switch (childMeta->type) {
+            case vm_uint8: {
               std::vector<uint8_t> *valuePointer = (std::vector<uint8_t> *)pointer;
               if (rowNr < (*valuePointer).size())
                 (*valuePointer).erase((*valuePointer).begin() + rowNr);
-            } else if (childVar["type"] == "number") {
+              break; }
+            case vm_uint16: {
               std::vector<uint16_t> *valuePointer = (std::vector<uint16_t> *)pointer;
               if (rowNr < (*valuePointer).size())
                 (*valuePointer).erase((*valuePointer).begin() + rowNr);
-            } else if (childVar["type"] == "checkbox") {
+              break; }
+            case vm_bool3State: {
               std::vector<bool3State> *valuePointer = (std::vector<bool3State> *)pointer;
               if (rowNr < (*valuePointer).size())
                 (*valuePointer).erase((*valuePointer).begin() + rowNr);
-            } else if (childVar["type"] == "text" || childVar["type"] == "fileEdit") {
+              break; }
+            case vm_text: {
               std::vector<VectorString> *valuePointer = (std::vector<VectorString> *)pointer;
               if (rowNr < (*valuePointer).size())
                 (*valuePointer).erase((*valuePointer).begin() + rowNr);
-            } else if (childVar["type"] == "coord3D") {
+              break; }
+            case vm_coord3D: {
               std::vector<Coord3D> *valuePointer = (std::vector<Coord3D> *)pointer;
               if (rowNr < (*valuePointer).size())
                 (*valuePointer).erase((*valuePointer).begin() + rowNr);
-            }
-            else
+              break; }
+            default:
               print->printJson("dev triggerEvent onDelete type not supported yet", childVar);
+            }
           }
         }
       } //onDelete
@@ -347,6 +353,81 @@
     return result; //varEvent exists
   }
 
+  static uint8_t varMetaType(const char *type) {
+    if (!type) return vm_other;
+    if (strcmp(type, "select") == 0 || strcmp(type, "range") == 0 || strcmp(type, "pin") == 0) return vm_uint8;
+    if (strcmp(type, "number") == 0) return vm_uint16;
+    if (strcmp(type, "checkbox") == 0) return vm_bool3State;
+    if (strcmp(type, "text") == 0 || strcmp(type, "fileEdit") == 0) return vm_text;
+    if (strcmp(type, "coord3D") == 0) return vm_coord3D;
+    if (strcmp(type, "button") == 0) return vm_button;
+    return vm_other;
+  }
+
+  VarMeta *Variable::meta() const {
+    JsonVariant metaNr = var["m"];
+    if (metaNr.isNull()) return nullptr;
+    uint16_t index = metaNr;
+    return index < mdl->varMetas.size()?&mdl->varMetas[index]:nullptr;
+  }
+
+  VarMeta &Variable::initMeta() {
+    VarMeta *varMeta = meta();
+    if (varMeta) return *varMeta;
+    uint16_t index = mdl->newVarMeta();
+    var["m"] = index;
+    varMeta = &mdl->varMetas[index];
+
+    //var read from model.json: its metadata moves out of the json
+    if (!var["type"].isNull()) {
+      varMeta->typeNr = mdl->varTypeNr(var["type"]);
+      varMeta->type = varMetaType(var["type"]);
+      var.remove("type");
+    }
+    varMeta->readOnly = var["ro"];
+    varMeta->min = var["min"];
+    varMeta->max = var["max"];
+    var.remove("ro");
+    var.remove("min");
+    var.remove("max");
+    return *varMeta;
+  }
+
+  const char *Variable::type() const {
+    VarMeta *varMeta = meta();
+    if (!varMeta) return var["type"];
+    return varMeta->typeNr < mdl->varTypes.size()?mdl->varTypes[varMeta->typeNr]:nullptr;
+  }
+
+  intptr_t Variable::pointer(uint8_t rowNr) const {
+    VarMeta *varMeta = meta();
+    if (!varMeta) return 0;
+    if (varMeta->rowPointers.size()) return rowNr < varMeta->rowPointers.size()?varMeta->rowPointers[rowNr]:0;
+    return varMeta->pointer;
+  }
+
+  bool Variable::coalesceChange(uint8_t rowNr, bool &firstChange) {
+    if (!mdl->coalesceChanges || mdl->syncDepth || !mdl->onLoopTask() || readOnly()) return false; //syncDepth and changeEvents are only used by the loop task
+    VarMeta *varMeta = meta();
+    if (varMeta && varMeta->syncChanges) return false;
+    const char *pid = this->pid();
+    const char *id = this->id();
+    if (!pid || !id) return false;
+
+    for (SysModModel::ChangeEvent &changeEvent: mdl->changeEvents) {
+      if (strcmp(changeEvent.id, id) == 0 && strcmp(changeEvent.pid, pid) == 0) {
+        firstChange = false;
+        if (changeEvent.rowNr == rowNr) return true; //already pending
+      }
+    }
+    SysModModel::ChangeEvent changeEvent;
+    strlcpy(changeEvent.pid, pid, sizeof(changeEvent.pid));
+    strlcpy(changeEvent.id, id, sizeof(changeEvent.id));
+    changeEvent.rowNr = rowNr;
+    mdl->changeEvents.push_back(changeEvent);
+    return true;
+  }
+
   void Variable::setLabel(const char * text) {
     web->addResponse(var, "label", text);
   }
@@ -470,22 +551,24 @@
       return var["value"];
   }
 
-  bool Variable::initValue(int min, int max, int pointer) {
+  bool Variable::initValue(int min, int max, intptr_t pointer) {
 
     if (pointer != 0) {
+      VarMeta &varMeta = initMeta();
       if (mdl->setValueRowNr == UINT8_MAX)
-        var["p"] = pointer; //store pointer!
-      else
-        var["p"][mdl->setValueRowNr] = pointer; //store pointer in array!
-      // ppf("initValue pointer stored %s: %s\n", id(), (void *)(var["p"].as<String>().c_str()));
+        varMeta.pointer = pointer; //store pointer!
+      else {
+        if (mdl->setValueRowNr >= varMeta.rowPointers.size()) varMeta.rowPointers.resize(mdl->setValueRowNr + 1, 0);
+        varMeta.rowPointers[mdl->setValueRowNr] = pointer; //store pointer in array!
+      }
     }
 
-    if (min) var["min"] = min;
-    if (max && max != UINT16_MAX) var["max"] = max;
+    if (min) minValue(min);
+    if (max && max != UINT16_MAX) maxValue(max);
 
     //value needs update if varVal not set yet or varVal is array and setValueRowNr is not in it
     bool doSetValue = false;
-    if (var["type"] != "button") { //button never gets a value
+    if (!isType("button")) { //button never gets a value
       if (var["value"].isNull()) {
         doSetValue = true;
         // print->printJson("initValue varEvent value is null", var);
@@ -512,16 +595,16 @@
     }
     else { //do onChange on existing value
       //no call of onChange for buttons otherwise all buttons will be fired which is highly undesirable
-      if (var["type"] != "button") { // && !var["fun"].isNull(): also if no varEvent to update pointers   !isPointer because 0 is also a value then && (!isPointer || value)
+      if (!isType("button")) { // && !var["fun"].isNull(): also if no varEvent to update pointers   !isPointer because 0 is also a value then && (!isPointer || value)
         bool onChangeExists = false;
         if (var["value"].is<JsonArray>()) {
           //refill the vector
           for (uint8_t rowNr = 0; rowNr < valArray().size(); rowNr++) {
-            onChangeExists |= triggerEvent(onChange, rowNr, true); //init, also set var["p"]
+            onChangeExists |= triggerEvent(onChange, rowNr, true); //init, also set the pointer
           }
         }
         else {
-          onChangeExists = triggerEvent(onChange, mdl->setValueRowNr, true); //init, also set var["p"] 
+          onChangeExists = triggerEvent(onChange, mdl->setValueRowNr, true); //init, also set the pointer 
         }
 
         if (onChangeExists)
@@ -541,8 +624,10 @@ SysModModel::SysModModel() :SysModule("Model") {
   if (files->readObjectFromFile("/model.json", model)) {//not part of success...
     // print->printJson("Read model", *model);
     // web->sendDataWs(*model);
+    replayJournal(); //changes saved after model.json was written
   } else {
     root = model->to<JsonArray>(); //re create the model as it is corrupted by readFromFile
+    files->remove(modelJournalFile); //changes to a snapshot which is not there
   }
 
   files->readObjectFromFile("/presets.json", presets); //do not create if not exists
@@ -557,7 +642,7 @@ void SysModModel::setup() {
 
   ui->initButton(parentVar, "saveModel", false, [this](EventArguments) { switch (eventType) {
     case onUI:
-      variable.setComment("Write to model.json");
+      variable.setComment("Write changes to model.json (via journal)");
       return true;
     case onChange:
       doWriteModel = true;
@@ -583,6 +668,7 @@ void SysModModel::setup() {
           ppf("deleteObsolete remove var %s.%s (no order)\n", variable.pid()?variable.pid():"-", variable.id());          
             // vars.remove(var); //remove the obsolete var (no o or )
           for (JsonArray::iterator it=vars.begin(); it!=vars.end(); ++it) if ((*it)["id"] == var["id"]) vars.remove(it); //use iterator to make .remove work!!!
+          varsRemoved();
         }
         return JsonObject(); //don't stop
       });
@@ -603,51 +689,213 @@ void SysModModel::setup() {
   #endif //STARBASE_DEVMODE
 }
 
+void SysModModel::loop() {
+  if (changeEvents.size()) dispatchChanges();
+}
+
+void SysModModel::dispatchChanges() {
+  std::vector<ChangeEvent> dispatching;
+  dispatching.swap(changeEvents);
+  for (ChangeEvent &changeEvent: dispatching) {
+    JsonObject var = findVar(changeEvent.pid, changeEvent.id);
+    if (var.isNull()) continue; //removed from the model since the change
+    Variable variable = Variable(var);
+    web->addResponse(var, "value", variable.value());
+    variable.triggerEvent(onChange, changeEvent.rowNr);
+  }
+}
+
 void SysModModel::loop20ms() {
 
-  if (doWriteModel) {
-    ppf("Writing model to /model.json... (serializeConfig)\n");
+  //compaction is done in a later loop than the save which made the journal too big, synchronous: the full writeModel
+  if (doCompactModel) {
+    writeModel();
+    doCompactModel = false;
+  }
+  else if (doWriteModel) {
+    File snapshot = files->open("/model.json", FILE_READ);
+    if (snapshot && snapshot.size()) { //journal only changes to an existing snapshot
+      snapshot.close();
+      if (writeJournal() > modelJournalMax) doCompactModel = true;
+    } else {
+      snapshot.close();
+      writeModel();
+    }
 
-    // files->writeObjectToFile("/model.json", model);
+    if (!presets->isNull())
+      files->writeObjectToFile("/presets.json", presets);
 
-    walkThroughModel([](JsonObject parentVar, JsonObject var) {
+    doWriteModel = false;
+  }
+}
 
-      Variable variable = Variable(var);
+void SysModModel::writeModel() {
+  ppf("Writing model to /model.json... (serializeConfig)\n");
 
-      //remove ro values (ro vars cannot be deleted as SM uses these vars)
-      // remove if var is ro or table is instance table (exception here, values don't need to be saved)
-      if (parentVar["id"] == "instances" || variable.readOnly()) {// && !value().isNull())
-        // ppf("remove ro value %s.%s\n", variable.pid(), variable.id());          
-        var.remove("value");
-      }
+  // files->writeObjectToFile("/model.json", model);
 
-      return JsonObject(); //don't stop
-    });
+  walkThroughModel([](JsonObject parentVar, JsonObject var) {
 
-    StarJson starJson("/model.json", FILE_WRITE); //open fileName for deserialize
-    //comment exclusions out in case of generating model.json for github
-    starJson.addExclusion("fun");
-    starJson.addExclusion("dash");
-    starJson.addExclusion("o"); //order: this must be deleted as it will be used to check on reboot 
-    starJson.addExclusion("p"); //pointer
-    starJson.addExclusion("oldValue");
-    starJson.writeJsonDocToFile(model);
+    Variable variable = Variable(var);
 
-    // print->printJson("Write model", *model); //this shows the model before exclusion
+    //remove ro values (ro vars cannot be deleted as SM uses these vars)
+    // remove if var is ro or table is instance table (exception here, values don't need to be saved)
+    if (parentVar["id"] == "instances" || variable.readOnly()) {// && !value().isNull())
+      // ppf("remove ro value %s.%s\n", variable.pid(), variable.id());          
+      var.remove("value");
+    }
 
-    if (!presets->isNull())
-      files->writeObjectToFile("/presets.json", presets);
+    return JsonObject(); //don't stop
+  });
 
+  StarJson starJson("/model.json", FILE_WRITE); //open fileName for deserialize
+  //comment exclusions out in case of generating model.json for github
+  starJson.addExclusion("fun");
+  starJson.addExclusion("dash");
+  starJson.addExclusion("o"); //order: this must be deleted as it will be used to check on reboot 
+  starJson.addExclusion("m"); //var meta index
+  starJson.addExtra([this](JsonObject var, JsonObject extra) {varMetaToJson(var, extra);}); //type, ro, min and max
+  starJson.addExclusion("oldValue");
+  starJson.writeJsonDocToFile(model);
+
+  // print->printJson("Write model", *model); //this shows the model before exclusion
+
+  //the snapshot contains all changes
+  files->remove(modelJournalFile);
+  changedVars.clear();
+  journalVars.clear(); //vars still not created are not saved in the snapshot
+}
 
-    doWriteModel = false;
+void SysModModel::varChanged(Variable variable) {
+  const char *pid = variable.pid();
+  const char *id = variable.id();
+  if (!pid || !id || strcmp(pid, "instances") == 0) return; //instances are not saved
+  for (ChangedVar &changedVar: changedVars)
+    if (strcmp(changedVar.pid, pid) == 0 && strcmp(changedVar.id, id) == 0) return; //e.g. slider moves: once per save
+  ChangedVar changedVar;
+  strlcpy(changedVar.pid, pid, sizeof(changedVar.pid));
+  strlcpy(changedVar.id, id, sizeof(changedVar.id));
+  changedVars.push_back(changedVar);
+}
+
+size_t SysModModel::writeJournal() {
+  File f = files->open(modelJournalFile, FILE_APPEND);
+  if (!f) {
+    ppf("writeJournal %s open not successful\n", modelJournalFile);
+    return 0;
+  }
+  size_t written = 0;
+  for (ChangedVar &changedVar: changedVars) {
+    JsonObject var = findVar(changedVar.pid, changedVar.id);
+    if (var.isNull()) continue; //removed from the model since the change (e.g. controls of another effect)
+    JsonDocument record;
+    record["pid"] = var["pid"];
+    record["id"] = var["id"];
+    record["value"] = var["value"]; //all rows if a table column
+    written += serializeJson(record, f);
+    written += f.write('\n');
   }
+  size_t size = f.size();
+  f.close();
+  ppf("writeJournal %d vars %d bytes, journal %d bytes\n", changedVars.size(), written, size);
+  changedVars.clear();
+  files->filesChanged = true;
+  return size;
+}
+
+void SysModModel::replayJournal() {
+  File f = files->open(modelJournalFile, FILE_READ);
+  if (!f) return;
+  uint16_t count = 0;
+  JsonDocument record;
+  while (f.available()) {
+    if (deserializeJson(record, f.readStringUntil('\n'))) continue; //e.g. last line cut by a power loss
+    const char *pid = record["pid"];
+    const char *id = record["id"];
+    if (!pid || !id) continue;
+    JsonObject var = findVarWalk(pid, id); //no index yet
+    if (var.isNull()) //var created after the snapshot: initVar takes the value when it creates the var
+      journalVars.add(record.as<JsonObject>());
+    else
+      var["value"] = record["value"];
+    count++;
+  }
+  f.close();
+  ppf("replayJournal %d changes, %d of vars not in the snapshot\n", count, journalVars.size());
 }
 
 void SysModModel::loop1s() {
-  walkThroughModel([](JsonObject parentVar, JsonObject var) {
-    Variable(var).triggerEvent(onLoop1s);
+  if (loop1sVarsValid) {
+    for (Variable &variable: loop1sVars) variable.triggerEvent(onLoop1s);
+    return;
+  }
+
+  //the vars changed: also free the metadata of vars not in the model anymore
+  std::vector<bool> metaInModel(varMetas.size(), false);
+  loop1sVars.clear();
+  walkThroughModel([this, &metaInModel](JsonObject parentVar, JsonObject var) {
+    Variable variable = Variable(var);
+    if (!var["m"].isNull() && var["m"].as<uint16_t>() < metaInModel.size()) metaInModel[var["m"].as<uint16_t>()] = true;
+    if (variable.triggerEvent(onLoop1s)) loop1sVars.push_back(variable); //handled
     return JsonObject(); //don't stop
   });
+  loop1sVarsValid = true;
+
+  for (uint16_t index = 0; index < varMetas.size(); index++) {
+    if (varMetas[index].used && !metaInModel[index]) {
+      varMetas[index] = VarMeta();
+      varMetasFree.push_back(index);
+    }
+  }
+}
+
+uint16_t SysModModel::newVarMeta() {
+  uint16_t index;
+  if (varMetasFree.size()) {
+    index = varMetasFree.back();
+    varMetasFree.pop_back();
+  } else {
+    index = varMetas.size();
+    varMetas.push_back(VarMeta());
+  }
+  varMetas[index].used = true;
+  return index;
+}
+
+uint8_t SysModModel::varTypeNr(const char *type) {
+  if (!type) return UINT8_MAX;
+  for (uint8_t typeNr = 0; typeNr < varTypes.size(); typeNr++)
+    if (strcmp(varTypes[typeNr], type) == 0) return typeNr;
+  if (varTypes.size() >= UINT8_MAX) {
+    ppf("dev varTypeNr too many types %s\n", type);
+    return UINT8_MAX;
+  }
+  varTypes.push_back(strdup(type));
+  return varTypes.size() - 1;
+}
+
+void SysModModel::varMetaToJson(JsonObject var, JsonObject dest) {
+  VarMeta *varMeta = Variable(var).meta();
+  if (!varMeta) return; //not initialized: still in the json
+  if (varMeta->typeNr < varTypes.size()) dest["type"] = (const char *)varTypes[varMeta->typeNr];
+  dest["ro"] = varMeta->readOnly;
+  if (varMeta->min) dest["min"] = varMeta->min;
+  if (varMeta->max) dest["max"] = varMeta->max;
+}
+
+void SysModModel::addVarMetaJson(JsonObject var) {
+  varMetaToJson(var, var);
+  var.remove("m");
+  for (JsonObject childVar: var["n"].as<JsonArray>()) addVarMetaJson(childVar);
+}
+
+//FNV-1a of pid.id
+static uint32_t varHash(const char * pid, const char * id) {
+  uint32_t hash = 2166136261u;
+  for (const char *c = pid; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619u;
+  hash = (hash ^ '.') * 16777619u;
+  for (const char *c = id; *c; c++) hash = (hash ^ (uint8_t)*c) * 16777619u;
+  return hash;
 }
 
 Variable SysModModel::initVar(Variable parent, const char * id, const char * type, bool readOnly, const VarEvent &varEvent) {
@@ -668,22 +916,35 @@ Variable SysModModel::initVar(Variable parent, const char * id, const char * typ
       // serializeJson(model, Serial);Serial.println();
     }
     var["id"] = JsonString(id);
+
+    //value saved in the journal after the snapshot was written, see replayJournal
+    JsonArray records = journalVars.as<JsonArray>();
+    for (size_t i = 0; i < records.size();) {
+      JsonObject record = records[i];
+      if (record["pid"] == parentId && record["id"] == id) {
+        var["value"] = record["value"]; //last record wins
+        records.remove(i);
+      } else
+        i++;
+    }
   }
   // else {
   //   ppf("initVar Var %s->%s already defined\n", modelParentId, id);
   // }
 
   if (!var.isNull()) {
-    if (var["type"].isNull() || var["type"] != type) {
-      var["type"] = JsonString(type);
-      // print->printJson("initVar set type", var);
-    }
-
     variable = Variable(var);
 
-    var["pid"] = parentId;
+    VarMeta &varMeta = variable.initMeta();
+    uint8_t typeNr = varTypeNr(type);
+    if (varMeta.typeNr != typeNr) {
+      varMeta.typeNr = typeNr;
+      varMeta.type = varMetaType(type);
+    }
+    varMeta.readOnly = readOnly;
 
-    if (var["ro"].isNull() || variable.readOnly() != readOnly) variable.readOnly(readOnly);
+    var["pid"] = parentId;
+    varIndexAdd(varHash(parentId, id), var);
 
     //set order
     if (variable.order() < 1000) //predefined! (modules) - positive as saved in model.json
@@ -701,6 +962,7 @@ Variable SysModModel::initVar(Variable parent, const char * id, const char * typ
       // else { //not found
         varEvents.push_back(varEvent); //add new function
         var["fun"] = varEvents.size()-1;
+        loop1sVarsValid = false; //it might handle onLoop1s
       // }
       
       if (varEvent(variable, UINT8_MAX, onLoop)) { //test run if it supports loop
@@ -725,6 +987,7 @@ void Variable::subscribe(uint8_t eventType, const VarFunction &varFunction) {
   ppf("subscribe %d %s.%s\n", eventType, pid(), id());
   mdl->varEventsPS.push_back({*this, eventType, varFunction}); //add new function
   var["fun"] = UINT8_MAX; //to trigger response from ui
+  if (eventType == onLoop1s) mdl->loop1sVarsValid = false;
 }
 
 bool Variable::publish(uint8_t eventType, uint8_t rowNr) {
@@ -755,14 +1018,59 @@ JsonObject SysModModel::walkThroughModel(std::function<JsonObject(JsonObject, Js
   return JsonObject(); //don't stop
 }
 
+void SysModModel::varIndexAdd(uint32_t hash, JsonObject var) {
+  if (((size_t)varIndexCount + 1) * 4 > varIndex.size() * 3) { //keep 25% free so probes stay short
+    std::vector<VarIndexEntry> oldIndex;
+    oldIndex.swap(varIndex);
+    varIndex.resize(max(oldIndex.size() * 2, (size_t)64));
+    varIndexCount = 0;
+    for (VarIndexEntry &entry: oldIndex)
+      if (!entry.var.isNull()) varIndexAdd(entry.hash, entry.var);
+  }
+  size_t mask = varIndex.size() - 1;
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+    if (varIndex[i].var.isNull()) {
+      varIndex[i] = {hash, var};
+      varIndexCount++;
+      return;
+    }
+    if (varIndex[i].hash == hash) {
+      JsonObject indexedVar = varIndex[i].var;
+      if (indexedVar["pid"] == var["pid"].as<const char *>() && indexedVar["id"] == var["id"].as<const char *>()) { //same var (initVar again)
+        varIndex[i].var = var;
+        return;
+      }
+    } //another var in this slot (or with the same hash): probe the next slot
+  }
+}
+
 JsonObject SysModModel::findVar(const char * pid, const char * id, JsonObject parentVar) {
+  if (!parentVar.isNull() || !pid || !id) return findVarWalk(pid, id, parentVar);
+
+  uint32_t hash = varHash(pid, id);
+  if (varIndex.size()) {
+    size_t mask = varIndex.size() - 1;
+    for (size_t i = hash & mask; !varIndex[i].var.isNull(); i = (i + 1) & mask) {
+      if (varIndex[i].hash == hash) {
+        JsonObject var = varIndex[i].var;
+        if (var["pid"] == pid && var["id"] == id) return var;
+      } //hash collision: the var can be in a next slot
+    }
+  }
+
+  JsonObject var = findVarWalk(pid, id);
+  if (!var.isNull()) varIndexAdd(hash, var);
+  return var;
+}
+
+JsonObject SysModModel::findVarWalk(const char * pid, const char * id, JsonObject parentVar) {
   for (JsonObject var : parentVar.isNull()?model->as<JsonArray>():parentVar["n"]) {
     if (var["pid"] == pid && var["id"] == id) { //(!pid && var["pid"] == pid) && 
       // Serial.printf("findVar found %s.%s!!\n", pid, id);
       return var;
     }
     else if (!var["n"].isNull()) {
-      JsonObject foundVar = findVar(pid, id, var);
+      JsonObject foundVar = findVarWalk(pid, id, var);
       if (!foundVar.isNull()) {
         return foundVar;
       }
@@ -211,6 +211,30 @@ enum eventTypes
   f_count
 };
 
+//native metadata of a var, var["m"] is its index in SysModModel::varMetas (as var["fun"] is for varEvents)
+//  set by initVar: type, ro and min/max are only here, SysModModel::varMetaToJson adds them to the json for the UI and model.json
+enum VarMetaType: uint8_t {
+  vm_other,
+  vm_uint8, //select, range, pin
+  vm_uint16, //number
+  vm_bool3State, //checkbox
+  vm_text, //text, fileEdit (VectorString)
+  vm_coord3D,
+  vm_button
+};
+
+struct VarMeta {
+  intptr_t pointer = 0; //bound value
+  std::vector<intptr_t> rowPointers; //bound value per row, if initialized with setValueRowNr (controls of table rows)
+  int min = 0; //0: no min
+  int max = 0; //0: no max
+  uint8_t typeNr = UINT8_MAX; //index in SysModModel::varTypes, UINT8_MAX: no type
+  uint8_t type = vm_other; //native type of the value
+  bool readOnly = false;
+  bool syncChanges = false; //onChange runs in setValue, also if changes are coalesced (see SysModModel::changeEvents)
+  bool used = false; //false if in the free list
+};
+
 class Variable; //forward
 
 typedef std::function<void(Variable)> FindFun;
@@ -235,7 +259,8 @@ class Variable {
   //core methods 
   const char *pid() const {return var["pid"];}
   const char *id() const {return var["id"];}
-  const char *type() const {return var["type"];}
+  const char *type() const;
+  bool isType(const char *name) const {const char *varType = type(); return varType && strcmp(varType, name) == 0;}
 
   JsonVariant value(uint8_t rowNr = UINT8_MAX) const {return (rowNr==UINT8_MAX)?var["value"].as<JsonVariant>(): var["value"][rowNr].as<JsonVariant>();}
 
@@ -244,8 +269,30 @@ class Variable {
   int order() const {return var["o"];}
   void order(int value) const {var["o"] = value;}
 
-  bool readOnly() const {return var["ro"];}
-  void readOnly(bool value) {var["ro"] = value;}
+  bool readOnly() const {VarMeta *varMeta = meta(); return varMeta?varMeta->readOnly:var["ro"].as<bool>();}
+  void readOnly(bool value) {initMeta().readOnly = value;}
+
+  int minValue() const {VarMeta *varMeta = meta(); return varMeta?varMeta->min:var["min"].as<int>();}
+  void minValue(int value) {initMeta().min = value;}
+  int maxValue() const {VarMeta *varMeta = meta(); return varMeta?varMeta->max:var["max"].as<int>();}
+  void maxValue(int value) {initMeta().max = value;}
+
+  //native metadata, created by initVar, nullptr for vars read from model.json which are not initialized (yet)
+  //  then type, ro, min and max are still in the json
+  VarMeta *meta() const;
+  VarMeta &initMeta();
+  //bound value of rowNr, 0 if none
+  intptr_t pointer(uint8_t rowNr = UINT8_MAX) const;
+
+  //opt out of coalesced changes, e.g. if the caller of setValue needs the result of onChange right away
+  void syncChanges(bool value = true) {initMeta().syncChanges = value;}
+
+  //true if onChange (and the ui response) of this change is dispatched later by SysModModel::loop
+  //  firstChange is false if it has a change pending already (then the oldValue of the first change is kept)
+  bool coalesceChange(uint8_t rowNr, bool &firstChange);
+
+  //sets the bound value (VarMeta pointer or rowPointers) to value(rowNr), by onChange and right away by a coalesced setValue
+  void writePointer(uint8_t rowNr = UINT8_MAX);
 
   //children (n) of variable
   JsonArray children();
@@ -292,7 +339,10 @@ class Variable {
 
     if (value(rowNr).isNull() || value(rowNr).as<Type>() != newValue) { //new or changed
 
-      if (!value().isNull() && !readOnly()) var["oldValue"] = value(); //save oldValue
+      bool firstChange = true;
+      bool coalesced = coalesceChange(rowNr, firstChange);
+
+      if (firstChange && !value().isNull() && !readOnly()) var["oldValue"] = value(); //save oldValue
 
       //save newValue, cleanup null values
       if (rowNr == UINT8_MAX) {
@@ -319,8 +369,11 @@ class Variable {
         }
       }
 
-      web->addResponse(var, "value", value());
-      triggerEvent(onChange, rowNr);
+      if (!coalesced) {
+        web->addResponse(var, "value", value());
+        triggerEvent(onChange, rowNr);
+      } else
+        writePointer(rowNr); //code after setValue sees the new value, onChange and the ui response follow in the loop
     }
 
   }
@@ -331,7 +384,7 @@ class Variable {
   JsonVariant getValue(uint8_t rowNr = UINT8_MAX);
 
   //gives a variable an initital value returns true if setValue must be called 
-  bool initValue(int min = 0, int max = 255, int pointer = 0);
+  bool initValue(int min = 0, int max = 255, intptr_t pointer = 0);
 
   void subscribe(uint8_t eventType, const VarFunction &varFunction = nullptr);
   bool publish(uint8_t eventType, uint8_t rowNr = UINT8_MAX);
@@ -345,6 +398,23 @@ struct VarEventPS {
   VarFunction varFunction; //function: 16 bytes
 }; //total 28 bytes
 
+//writer for SysModModel::serializeVars into buffer (size bytes, not null terminated). buffer nullptr: only counts, as measureJson
+struct JsonBufferWriter {
+  uint8_t *buffer;
+  size_t size;
+  size_t length = 0;
+  JsonBufferWriter(uint8_t *buffer = nullptr, size_t size = 0): buffer(buffer), size(size) {}
+  size_t write(uint8_t c) {
+    if (length < size) buffer[length] = c;
+    length++;
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t n) {
+    if (length < size) memcpy(buffer + length, data, min(n, size - length));
+    length += n;
+    return n;
+  }
+};
 
 class SysModModel: public SysModule {
 
@@ -356,6 +426,42 @@ public:
 
   bool doWriteModel = false;
 
+  //model persistence: model.json is the snapshot, saveModel appends the vars changed since the last save to the journal
+  //  (one json object per line), boot replays the journal on the snapshot. If the journal grows over modelJournalMax
+  //  it is compacted: deferred to the next loop20ms, not in the background: writeModel runs there synchronously on the
+  //  loop task (the model cannot be written while the loop task changes it), as a save without journal always did
+  #define modelJournalFile "/modeljournal.json"
+  #define modelJournalMax 4096
+  struct ChangedVar {
+    char pid[32];
+    char id[32];
+  };
+  std::vector<ChangedVar> changedVars; //since last save, not Variable as vars can be removed from the model
+  bool doCompactModel = false;
+  //journal records of vars not in the snapshot (created after model.json was written), replay doesn't create vars:
+  //  initVar takes the value when it creates the var. Until the next writeModel
+  JsonDocument journalVars;
+  void varChanged(Variable variable);
+
+  //coalesced changes: setValue in the loop task on a var which is not ro and not syncChanges, outside events (syncDepth 0),
+  //  e.g. by E1.31, instance sync or scripts, only stores the value and sets the bound value (VarMeta pointer) right away.
+  //  onChange and the ui response are dispatched once per var and rowNr per loop, with the final value. Values set during
+  //  setup and in other tasks (processJson in the web task) are synchronous, so syncDepth and changeEvents are only used by the loop task
+  struct ChangeEvent {
+    char pid[32];
+    char id[32];
+    uint8_t rowNr;
+  };
+  std::vector<ChangeEvent> changeEvents;
+  bool coalesceChanges = false; //set by SysModules::setup
+  TaskHandle_t loopTask = nullptr; //set by SysModules::setup
+  bool onLoopTask() {return xTaskGetCurrentTaskHandle() == loopTask;}
+  uint8_t syncDepth = 0; //>0 within events of the loop task: changes made there are synchronous
+  void dispatchChanges();
+  void writeModel(); //full write of model.json
+  size_t writeJournal(); //returns the journal size
+  void replayJournal();
+
   uint8_t setValueRowNr = UINT8_MAX;
   uint8_t getValueRowNr = UINT8_MAX;
   int varCounter = 1; //start with 1 so it can be negative, see var["o"]
@@ -367,6 +473,7 @@ public:
 
   SysModModel();
   void setup() override;
+  void loop() override;
   void loop20ms() override;
   void loop1s() override;
 
@@ -398,7 +505,89 @@ public:
 
   //returns the var defined by id (parent to recursively call findVar)
   JsonObject walkThroughModel(std::function<JsonObject(JsonObject, JsonObject)> fun, JsonObject parentVar = JsonObject());
+  //from the model root via the var index, walking the model only if not indexed yet
   JsonObject findVar(const char * pid, const char * id, JsonObject parentVar = JsonObject());
+  JsonObject findVarWalk(const char * pid, const char * id, JsonObject parentVar = JsonObject()); //without index
+
+  //var index: hash of pid.id -> var, open addressing (power of 2 size, linear probing), filled by initVar and findVar
+  //  vars removed from the model (details of effects / projections, obsolete vars) clear the whole index, it fills again on lookup
+  struct VarIndexEntry {
+    uint32_t hash;
+    JsonObject var; //null if free
+  };
+  std::vector<VarIndexEntry> varIndex;
+  uint16_t varIndexCount = 0;
+  void varIndexAdd(uint32_t hash, JsonObject var);
+  void varIndexClear() {
+    varIndex.clear();
+    varIndexCount = 0;
+  }
+
+  //vars handling onLoop1s, loop1s visits only these. After vars with events are added or vars are removed,
+  //  loop1s walks the model once and the vars which return true on onLoop1s register again
+  std::vector<Variable> loop1sVars;
+  bool loop1sVarsValid = false;
+
+  //native metadata of the vars, see VarMeta. Entries of vars removed from the model are freed by the loop1s walk
+  std::vector<VarMeta> varMetas;
+  std::vector<uint16_t> varMetasFree;
+  uint16_t newVarMeta();
+  std::vector<char *> varTypes; //type names of VarMeta::typeNr, each stored once
+  uint8_t varTypeNr(const char *type);
+  //adds type, ro, min and max of var to dest (the var itself if dest is a copy of it)
+  void varMetaToJson(JsonObject var, JsonObject dest);
+  //on a copy of vars (details response): adds the metadata of the var and its children and removes m
+  void addVarMetaJson(JsonObject var);
+
+  //serializeJson of vars (a var, a module or the model) with the metadata of VarMeta added and without m,
+  //  written while walking the model so no copy is needed (ui, serveJson). Writer as for serializeJson: write(uint8_t) and write(const uint8_t *, size_t)
+  template <typename Writer>
+  void serializeVars(JsonVariant json, Writer &writer) {
+    if (json.is<JsonObject>()) {
+      JsonObject var = json.as<JsonObject>();
+      bool first = true;
+      auto writeKey = [&writer, &first](const char *key) {
+        if (!first) writer.write((uint8_t)',');
+        first = false;
+        writer.write((uint8_t)'"'); writer.write((const uint8_t *)key, strlen(key)); writer.write((const uint8_t *)"\":", 2);
+      };
+      writer.write((uint8_t)'{');
+      for (JsonPair pair: var) {
+        if (pair.key() == "m") continue;
+        writeKey(pair.key().c_str());
+        serializeVars(pair.value(), writer);
+      }
+      VarMeta *varMeta = Variable(var).meta();
+      if (varMeta) { //same as varMetaToJson
+        char number[12];
+        if (varMeta->typeNr < varTypes.size()) {
+          writeKey("type");
+          writer.write((uint8_t)'"'); writer.write((const uint8_t *)varTypes[varMeta->typeNr], strlen(varTypes[varMeta->typeNr])); writer.write((uint8_t)'"');
+        }
+        writeKey("ro");
+        writer.write((const uint8_t *)(varMeta->readOnly?"true":"false"), varMeta->readOnly?4:5);
+        if (varMeta->min) {writeKey("min"); writer.write((const uint8_t *)number, snprintf(number, sizeof(number), "%d", varMeta->min));}
+        if (varMeta->max) {writeKey("max"); writer.write((const uint8_t *)number, snprintf(number, sizeof(number), "%d", varMeta->max));}
+      }
+      writer.write((uint8_t)'}');
+    } else if (json.is<JsonArray>()) {
+      bool first = true;
+      writer.write((uint8_t)'[');
+      for (JsonVariant element: json.as<JsonArray>()) {
+        if (!first) writer.write((uint8_t)',');
+        first = false;
+        serializeVars(element, writer);
+      }
+      writer.write((uint8_t)']');
+    } else
+      serializeJson(json, writer);
+  }
+
+  //call after removing vars from the model
+  void varsRemoved() {
+    varIndexClear();
+    loop1sVarsValid = false;
+  }
   JsonObject findModule(const char * pid, const char * id);
   void findVars(const char * id, bool value, FindFun fun, JsonObject parentVar = JsonObject());
 
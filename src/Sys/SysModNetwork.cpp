@@ -86,6 +86,7 @@ void SysModNetwork::setup() {
       //initEthernet not done in onChange as initEthernet needs a bit of a delay
       if (!ethActive && variable.getValue().as<bool>())
         initEthernet();
+      return true;
     default: return false;
     }});
 
@@ -93,7 +93,7 @@ public:
       #elif defined(ESP32)
         if (pin > 5 && pin < 12) pinType = pinTypeReserved; else 
       #else //???
-        prf("dev unknown board\n");
+        ppf("dev unknown board\n");
         pinType = pinTypeInvalid; return pinType; 
       #endif
 
@@ -119,7 +119,7 @@ void SysModSystem::setup() {
 
   ui->initProgress(parentVar, "heap", 0, 0, ESP.getHeapSize()/1000, true, [](EventArguments) { switch (eventType) {
     case onChange:
-      variable.var["max"] = ESP.getHeapSize()/1000; //makes sense?
+      variable.maxValue(ESP.getHeapSize()/1000); //makes sense?
       web->addResponse(variable.var, "comment", "f:%d / t:%d (l:%d) B [%d %d]", ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMaxAllocHeap(), esp_get_free_heap_size(), esp_get_free_internal_heap_size());
       //temporary add esp_get_free_heap_size(), esp_get_free_internal_heap_size() to see if/how it differs
       //esp_get_free_heap_size can be bigger in case of heap
@@ -133,7 +133,7 @@ void SysModSystem::setup() {
   if (psramFound()) {
     ui->initProgress(parentVar, "psram", 0, 0, ESP.getPsramSize()/1000, true, [](EventArguments) { switch (eventType) {
       case onChange:
-        variable.var["max"] = ESP.getPsramSize()/1000; //makes sense?
+        variable.maxValue(ESP.getPsramSize()/1000); //makes sense?
         web->addResponse(variable.var, "comment", "%d / %d (%d) B", ESP.getFreePsram(), ESP.getPsramSize(), ESP.getMinFreePsram());
         return true;
     case onLoop1s:
@@ -145,7 +145,7 @@ void SysModSystem::setup() {
 
   ui->initProgress(parentVar, "mainStack", 0, 0, getArduinoLoopTaskStackSize(), true, [this](EventArguments) { switch (eventType) {
     case onChange:
-      variable.var["max"] = getArduinoLoopTaskStackSize(); //makes sense?
+      variable.maxValue(getArduinoLoopTaskStackSize()); //makes sense?
       web->addResponse(variable.var, "comment", "%d of %d B", sysTools_get_arduino_maxStackUsage(), getArduinoLoopTaskStackSize());
       return true;
     case onLoop1s:
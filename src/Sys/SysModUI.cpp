@@ -98,6 +98,10 @@ void SysModUI::processJson(JsonVariant json) {
 
           Variable(var).triggerEvent(pair.key() == "onAdd"?onAdd:onDelete, rowNr);
 
+          //for the journal: the row is added to all columns, also the ones without onChange (removeValuesForRow does this for onDelete)
+          if (pair.key() == "onAdd")
+            for (JsonObject childVar: Variable(var).children()) mdl->varChanged(Variable(childVar));
+
           //first remove the deleted row both on server and on client(s)
           if (pair.key() == "onDelete") {
             ppf("onDelete remove removeValuesForRow\n");
@@ -168,7 +172,7 @@ void SysModUI::processJson(JsonVariant json) {
           {
             mdl->resetPresetThreshold++;
             //a button never sets the value
-            if (var["type"] == "button") { //button always
+            if (Variable(var).isType("button")) { //button always
               Variable(var).triggerEvent(onChange, rowNr);
               if (rowNr != UINT8_MAX) web->getResponseObject()[pidid]["rowNr"] = rowNr;
             }
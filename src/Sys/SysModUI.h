@@ -188,7 +188,7 @@ public:
   Variable initVarAndValue(Variable parent, const char * id, const char * type, Type * value, int min = 0, int max = 255, bool readOnly = true, const VarEvent &varEvent = nullptr) {
     Variable variable = mdl->initVar(parent, id, type, readOnly, varEvent);
 
-    if (variable.initValue(min, max, int(value))) {
+    if (variable.initValue(min, max, (intptr_t)value)) {
       variable.setValue(*value, mdl->setValueRowNr); //does onChange if needed, if var in table, update the table row
     }
 
@@ -205,7 +205,7 @@ public:
       (*values).clear(); // if values already then rebuild the vector with it
     }
 
-    if (variable.initValue(min, max, (int)values)) {
+    if (variable.initValue(min, max, (intptr_t)values)) {
       uint8_t rowNrL = 0;
       for (Type value: *values) { //loop over vector
         variable.setValue(value, rowNrL); //does onChange if needed, if var in table, update the table row
@@ -225,7 +225,7 @@ public:
       (*values).clear(); // if values already then rebuild the vector with it
     }
 
-    if (variable.initValue(min, max, (int)values)) {
+    if (variable.initValue(min, max, (intptr_t)values)) {
       uint8_t rowNrL = 0;
       for (VectorString value: *values) { //loop over vector
         variable.setValue(JsonString(value.s), rowNrL); //does onChange if needed, if var in table, update the table row
@@ -52,6 +52,7 @@ void SysModWeb::setup() {
     case onLoop1s:
       for (JsonObject childVar: variable.children())
         Variable(childVar).triggerEvent(onSetValue); //set the value (WIP)
+      return true;
     default: return false;
   }});
 
@@ -113,6 +114,7 @@ void SysModWeb::setup() {
       sendWsCounter = 0;
       sendWsTBytes = 0;
       sendWsBBytes = 0;
+      return true;
     default: return false;
   }});
 
@@ -139,6 +141,7 @@ void SysModWeb::setup() {
       variable.setValueF("#: %d /s %d B/s", recvUDPCounter, recvUDPBytes);
       recvUDPCounter = 0;
       recvUDPBytes = 0;
+      return true;
     default: return false;
   }});
 
@@ -148,7 +151,7 @@ void SysModWeb::loop20ms() {
 
   //currently not used as each variable is send individually
   if (this->modelUpdated) {
-    sendDataWs(*mdl->model); //send new data, all clients, no def
+    sendVarsWs(mdl->model->as<JsonVariant>()); //send new data, all clients, no def
 
     this->modelUpdated = false;
   }
@@ -282,7 +285,7 @@ void SysModWeb::wsEvent(WebSocket * ws, WebClient * client, AwsEventType type, v
 
     //send model per module to stay under websocket size limit of 8192
     for (const ArrayIndexSortValue &aisv : aisvs) {
-      sendDataWs(model[aisv.index], client); //send definition to client
+      sendVarsWs(model[aisv.index], client); //send definition to client
     }
 
     clientsChanged = true;
@@ -411,6 +414,18 @@ void SysModWeb::sendDataWs(JsonVariant json, WebClient * client) {
   }, len, false, client); //false -> text
 }
 
+//vars with their metadata (type, ro, min, max, see VarMeta), serialized from the model itself
+void SysModWeb::sendVarsWs(JsonVariant vars, WebClient * client) {
+
+  JsonBufferWriter measure;
+  mdl->serializeVars(vars, measure);
+  size_t len = measure.length;
+  sendDataWs([vars, len](AsyncWebSocketMessageBuffer * wsBuf) {
+    JsonBufferWriter writer(wsBuf->get(), len);
+    mdl->serializeVars(vars, writer);
+  }, len, false, client); //false -> text
+}
+
 //https://kcwong-joe.medium.com/passing-a-function-as-a-parameter-in-c-a132e69669f6
 void SysModWeb::sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fill, size_t len, bool isBinary, WebClient * client) {
 
@@ -779,12 +794,13 @@ void SysModWeb::serveJson(WebRequest *request) {
   // return model.json
   if (request->url().indexOf("mdl") > 0) {
     JsonArray model = mdl->model->as<JsonArray>();
-    ppf("serveJson model ...%d, %s %d %d\n", request->client()->remoteIP()[3], request->url().c_str(), model.size(),  measureJson(model));
-
-    response = new AsyncJsonResponse(true); //array, removed size as ArduinoJson v7 doesnt care (tbd: here copy is mode, see WLED for using reference)
-    JsonArray root = response->getRoot();
+    ppf("serveJson model ...%d, %s %d\n", request->client()->remoteIP()[3], request->url().c_str(), model.size());
 
-    root.set(model);
+    //streamed from the model with the metadata of the vars (type, ro, min, max, see VarMeta), no copy of the model
+    AsyncResponseStream *stream = request->beginResponseStream("application/json");
+    mdl->serializeVars(model, *stream);
+    request->send(stream);
+    return;
   } else { //WLED compatible
     ppf("serveJson ...%d, %s\n", request->client()->remoteIP()[3], request->url().c_str());
     response = new AsyncJsonResponse(false); //object. removed size as ArduinoJson v7 doesnt care
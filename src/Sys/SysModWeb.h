@@ -12,6 +12,7 @@
 #pragma once
 #include "SysModule.h"
 #include "SysModPrint.h"
+#include <atomic>
 
 #ifdef STARBASE_USE_Psychic
   #include <PsychicHttp.h>
@@ -57,7 +58,7 @@ public:
   uint8_t recvUDPCounter = 0;
   uint16_t recvUDPBytes = 0;
 
-  bool isBusy = false;
+  std::atomic<bool> isBusy{false}; //atomic: also read by the output task of the fixture on the other core
 
   #ifdef STARBASE_USERMOD_LIVE
     char lastFileUpdated[30] = ""; //workaround!
@@ -77,6 +78,7 @@ public:
   
   //send json to client or all clients
   void sendDataWs(JsonVariant json = JsonVariant(), WebClient * client = nullptr);
+  void sendVarsWs(JsonVariant vars, WebClient * client = nullptr);
   void sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fill, size_t len, bool isBinary, WebClient * client = nullptr);
   void sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client = nullptr, bool lossless = true);
 
@@ -16,7 +16,7 @@
 
 //Lazy Json Read Deserialize Write Serialize (write / serialize not implemented yet)
 //ArduinoJson won't work on very large fixture.json, this does
-//only support what is currently needed: read / deserialize uint8/16/char var elements (arrays not yet)
+//only support what is currently needed: read / deserialize uint8/char var elements and arrays of numbers
   StarJson::StarJson(const char * path, const char * mode) {
     // ppf("StarJson constructing %s %s\n", path, mode);
     f = files->open(path, mode);
@@ -33,6 +33,10 @@
     charList.push_back((char *)key);
   }
 
+  void StarJson::addExtra(const std::function<void(JsonObject object, JsonObject extra)>& fun) {
+    extraFun = fun;
+  }
+
   //serializeJson
   void StarJson::writeJsonDocToFile(JsonDocument* dest) {
     writeJsonVariantToFile(dest->as<JsonVariant>());
@@ -42,35 +46,30 @@
 
   void StarJson::lookFor(const char * id, uint8_t * value) {
     uint8List.push_back(value);
-    addToVars(id, "uint8", uint8List.size()-1);
+    addToVars(id, vt_uint8, uint8List.size()-1);
   }
 
-  // void StarJson::lookFor(const char * id, uint16_t * value) {
-  //   uint16List.push_back(value);
-  //   addToVars(id, "uint16", uint16List.size()-1);
-  // }
-
-  // void StarJson::lookFor(const char * id, int * value) {
-  //   intList.push_back(value);
-  //   addToVars(id, "int", intList.size()-1);
-  // }
+  void StarJson::lookFor(const char * id, uint16_t * value) {
+    uint16List.push_back(value);
+    addToVars(id, vt_uint16, uint16List.size()-1);
+  }
 
   void StarJson::lookFor(const char * id, char * value) {
     charList.push_back(value);
-    addToVars(id, "char", charList.size()-1);
+    addToVars(id, vt_char, charList.size()-1);
   }
 
-  //look for array of integers
-  void StarJson::lookFor(const char * id, const std::function<void(std::vector<uint16_t>)>& fun) {
+  //look for array of numbers
+  void StarJson::lookFor(const char * id, const std::function<void(const float *numbers, uint8_t count)>& fun) {
     funList.push_back(fun);
-    addToVars(id, "fun", funList.size()-1);
+    addToVars(id, vt_fun, funList.size()-1);
   }
 
   //reads from file until all vars have been found (then stops reading)
   //returns false if not all vars to look for are found
   bool StarJson::deserialize(const bool lazy) {
-    f.read(&character, sizeof(byte));
-    while (f.available() && (!foundAll || !lazy))
+    read();
+    while (!endOfFile && (!foundAll || !lazy))
       next();
     if (foundAll)
       ppf("StarJson found all what it was looking for %d >= %d\n", foundCounter, varDetails.size());
@@ -81,7 +80,7 @@
   }
 
   //called by lookedFor, store the var details in varDetails
-  void StarJson::addToVars(const char * id, const char * type, const size_t index) {
+  void StarJson::addToVars(const char * id, const VarType type, const size_t index) {
     VarDetails vd;
     vd.id = id;
     vd.type = type;
@@ -90,123 +89,104 @@
   }
 
   void StarJson::next() {
-    if (character=='{') { //object begin
-      // ppf("Object %c\n", character);
-      varStack.push_back(lastVarId); //copy!!
-      // ppf("Object push %s %d\n", lastVarId, varStack.size());
-      strlcpy(lastVarId, "", sizeof(lastVarId));
-      f.read(&character, sizeof(byte));
-    }
-    else if (character=='}') { //object end
-      strlcpy(lastVarId, varStack[varStack.size()-1].c_str(), sizeof(lastVarId));
-      // ppf("Object pop %s %d\n", lastVarId, varStack.size());
-      check(lastVarId);
-      varStack.pop_back();
-      f.read(&character, sizeof(byte));
-    }
-    else if (character=='[') { //array begin
-      // ppf("Array %c\n", character);
-      varStack.push_back(lastVarId); //copy!!
-      // ppf("Array push %s %d\n", lastVarId, varStack.size());
-      strlcpy(lastVarId, "", sizeof(lastVarId));
-      f.read(&character, sizeof(byte));
-
-      //now we want to collect the array elements
-      collectNumbers = true;
-      uint16CollectList.clear(); //to be sure not to have old numbers (e.g. pin)
+    if (character=='{' || character=='[') { //object or array begin
+      if (varStackDepth < starJsonDepth)
+        strlcpy(varStack[varStackDepth], lastVarId, sizeof(varStack[0])); //copy!!
+      varStackDepth++;
+      lastVarId[0] = '\0';
+
+      if (character=='[') {
+        //now we want to collect the array elements
+        collectNumbers = true;
+        numbersCount = 0; //to be sure not to have old numbers (e.g. pin)
+      }
+      read();
     }
-    else if (character==']') { //array end
-      //assign back the popped var id from [
-      strlcpy(lastVarId, varStack[varStack.size()-1].c_str(), sizeof(lastVarId));
-      // ppf("Array pop %s %d %d\n", lastVarId, varStack.size(), uint16CollectList.size());
+    else if (character=='}' || character==']') { //object or array end
+      if (varStackDepth == 0) { //not balanced
+        read();
+        return;
+      }
+      //assign back the popped var id from { or [
+      strlcpy(lastVarId, varStackId(varStackDepth - 1), sizeof(lastVarId));
       check(lastVarId);
 
-      //check the parent array, if exists
-      if (varStack.size() - 2 >= 0) {
-        // ppf("  Parent check %s\n", varStack[varStack.size()-2].c_str());
-        strlcpy(beforeLastVarId, varStack[varStack.size()-2].c_str(), sizeof(beforeLastVarId));
-        check(beforeLastVarId);
+      if (character==']') {
+        //check the parent array, if exists
+        if (varStackDepth >= 2)
+          check(varStackId(varStackDepth - 2));
+        collectNumbers = false;
+        numbersCount = 0;
       }
-      varStack.pop_back(); //remove var id of this array
-      collectNumbers = false;
-      uint16CollectList.clear();
-      f.read(&character, sizeof(byte));
+      varStackDepth--; //remove var id of this object or array
+      read();
     }
     else if (character=='"') { //parse String
-      char value[128] = "";
-      f.readBytesUntil('"', value, sizeof(value)-1);
-    
+      char value[128];
+      size_t len = 0;
+      while (read() && character != '"') {
+        if (character == '\\' && !read()) break; //escaped character
+        if (len < sizeof(value) - 1) value[len++] = character;
+      }
+      value[len] = '\0';
+
       //if no lastVar then var found
-      if (strncmp(lastVarId, "", sizeof(lastVarId)) == 0) {
-        // ppf("Element [%s]\n", value);
+      if (lastVarId[0] == '\0') {
         strlcpy(lastVarId, value, sizeof(lastVarId));
       }
       else { // if lastvar then string value found
-        // ppf("String var %s: [%s]\n", lastVarId, value);
         check(lastVarId, value);
-        strlcpy(lastVarId, "", sizeof(lastVarId));
+        lastVarId[0] = '\0';
       }
 
-      f.read(&character, sizeof(byte));
+      read();
     }
-    else if (isDigit(character)) { //parse number
-      char value[100] = "";
-
+    else if (isDigit(character) || character=='-') { //parse number
+      char value[starJsonIdLength + 1];
       size_t len = 0;
-      //readuntil not number
-      while (isDigit(character)) {
-        // ppf("%c", character);
-        value[len++] = character;
-        f.read(&character, sizeof(byte));
-      }
-      value[len++] = '\0';
+      bool negative = character=='-';
+      bool integer = true; //no decimal point or exponent
+      int32_t integerValue = 0;
+
+      //read until not number
+      do {
+        if (len < sizeof(value) - 1) value[len++] = character;
+        if (isDigit(character))
+          integerValue = integerValue * 10 + (character - '0');
+        else if (character != '-')
+          integer = false;
+      } while (read() && (isDigit(character) || character=='.' || character=='e' || character=='E' || character=='-' || character=='+'));
+      value[len] = '\0';
 
       //number value found
-      // ppf("Number var %s: [%s]\n", lastVarId, value);
-      if (collectNumbers)
-        uint16CollectList.push_back(strtol(value, nullptr, 10));
+      if (collectNumbers && numbersCount < starJsonNumbers)
+        numbers[numbersCount++] = integer?(negative?-integerValue:integerValue):strtof(value, nullptr);
 
       check(lastVarId, value);
-  
-      strlcpy(lastVarId, "", sizeof(lastVarId));
-    }
-    else if (character==':') {
-      // ppf("semicolon %c\n", character);
-      f.read(&character, sizeof(byte));
-    }
-    else if (character==',') {
-      // ppf("sep %c\n", character);
-      f.read(&character, sizeof(byte));
-    }
-    else if (character==']') {
-      // ppf("close %c\n", character);
-      f.read(&character, sizeof(byte));
-    }
-    else if (character=='}') {
-      // ppf("close %c\n", character);
-      f.read(&character, sizeof(byte));
+
+      lastVarId[0] = '\0';
     }
-    else if (character=='\n') { //skip new lines
-      // ppf("skip newline \n");
-      f.read(&character, sizeof(byte));
+    else if (character==',') { //next element: the id of a closed object or array is not the id of the next
+      lastVarId[0] = '\0';
+      read();
     }
-    else {
-      // ppf("%c", character);
-      f.read(&character, sizeof(byte));
+    else { //: whitespace, true, false, null
+      read();
     }
   } //next
 
-  void StarJson::check(char * varId, char * value) {
+  void StarJson::check(const char * varId, const char * value) {
+    if (varId[0] == '\0') return; //array elements: no id to look for
+
     //check if var is in lookFor list
-    for (std::vector<VarDetails>::iterator vd=varDetails.begin(); vd!=varDetails.end(); ++vd) {
-      // ppf("check %s %s %s\n", vd->id, varId, value);
-      if (strncmp(vd->id, varId, 32)==0) {
-        // ppf("StarJson found %s:%s %d %s %d %d\n", varId, vd->type, vd->index, value?value:"", uint16CollectList.size(), funList.size());
-        if (strncmp(vd->type, "uint8", 7) ==0 && value) *uint8List[vd->index] = strtol(value, nullptr, 10);
-        // if (strncmp(vd->type, "uint16", 7) ==0 && value) *uint16List[vd->index] = strtol(value, nullptr, 10);
-        // if (strncmp(vd->type, "int", 7) ==0 && value) *intList[vd->index] = strtol(value, nullptr, 10);
-        if (strncmp(vd->type, "char", 5) ==0 && value) strlcpy(charList[vd->index], value, 32); //assuming size 32 here
-        if (strncmp(vd->type, "fun", 4) ==0) funList[vd->index](uint16CollectList); //call for every found item (no value check)
+    for (const VarDetails &vd: varDetails) {
+      if (vd.id[0] == varId[0] && strncmp(vd.id, varId, starJsonIdLength)==0) {
+        switch (vd.type) {
+          case vt_uint8: if (value) *uint8List[vd.index] = strtol(value, nullptr, 10); break;
+          case vt_uint16: if (value) *uint16List[vd.index] = strtol(value, nullptr, 10); break;
+          case vt_char: if (value) strlcpy(charList[vd.index], value, 32); break; //assuming size 32 here
+          case vt_fun: funList[vd.index](numbers, numbersCount); break; //call for every found item (no value check)
+        }
         foundCounter++;
       }
     }
@@ -234,6 +214,16 @@
           writeJsonVariantToFile(pair.value());
         }
       }
+      if (extraFun) {
+        JsonDocument extraDoc; //allocates only if fun adds pairs
+        JsonObject extra = extraDoc.to<JsonObject>();
+        extraFun(variant.as<JsonObject>(), extra);
+        for (JsonPair pair: extra) {
+          f.printf("%s\"%s\":", sep, pair.key().c_str());
+          strlcpy(sep, ",", sizeof(sep));
+          writeJsonVariantToFile(pair.value());
+        }
+      }
       f.printf("}");
     }
     else if (variant.is<JsonArray>()) {
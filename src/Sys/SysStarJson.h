@@ -17,7 +17,13 @@
 
 //Lazy Json Read Deserialize Write Serialize (write / serialize not implemented yet)
 //ArduinoJson won't work on very large fixture.json, this does
-//only support what is currently needed: read / deserialize uint8/16/char var elements (arrays not yet)
+//only support what is currently needed: read / deserialize uint8/char var elements and arrays of numbers
+//streaming: the file is read in blocks, the path is kept in fixed size tokens and numbers are collected in a fixed buffer, no allocations while parsing
+#define starJsonBufferSize 512 //bytes read from file at once
+#define starJsonDepth 16 //nesting of objects and arrays, ids deeper than this are not checked
+#define starJsonIdLength 32 //var id (and value) length compared
+#define starJsonNumbers 16 //numbers collected of one array, e.g. x,y,z
+
 class StarJson {
 
   public:
@@ -27,56 +33,78 @@ class StarJson {
   ~StarJson();
 
   void addExclusion(const char * key);
+  //called for each object written, the pairs fun adds to extra are written after the pairs of the object
+  void addExtra(const std::function<void(JsonObject object, JsonObject extra)>& fun);
 
   //serializeJson
   void writeJsonDocToFile(JsonDocument* dest);
 
-  //look for uint8 var
-  // void lookFor(const char * id, uint8_t * value) {
-  //   // const char *p = (const char*)&value; //pointer trick
-  //   uint8List.push_back(value);
-  //   addToVars(id, "uint8", uint8List.size()-1);
-  // }
-
   void lookFor(const char * id, uint8_t * value);
-  // void lookFor(const char * id, uint16_t * value);
-  // void lookFor(const char * id, int * value);
+  void lookFor(const char * id, uint16_t * value);
   void lookFor(const char * id, char * value);
-  void lookFor(const char * id, const std::function<void(std::vector<uint16_t>)>& fun);
+  //array of numbers: called at the end of each array with its numbers (integer, negative or decimal), numbers is only valid during the call
+  //  also called for the arrays in the array (e.g. "leds":[[x,y,z],...]), count is 0 at the end of the outer array
+  void lookFor(const char * id, const std::function<void(const float *numbers, uint8_t count)>& fun);
 
   //reads from file until all vars have been found (then stops reading)
   //returns false if not all vars to look for are found
   bool deserialize(bool lazy = false);
 
 private:
+  enum VarType {vt_uint8, vt_uint16, vt_char, vt_fun};
+
   struct VarDetails {
     const char * id;
-    const char * type;
+    VarType type;
     size_t index;
   };
 
   File f;
+  byte buffer[starJsonBufferSize]; //block read from file
+  size_t bufferLength = 0;
+  size_t bufferIndex = 0;
+  bool endOfFile = false;
   byte character; //the last character parsed
   std::vector<VarDetails> varDetails; //details of vars looking for
   std::vector<uint8_t *> uint8List; //pointer of uint8 to assign found values to (index of list stored in varDetails)
-  // std::vector<uint16_t *> uint16List; //same for uint16
-  // std::vector<int *> intList; //same for int
+  std::vector<uint16_t *> uint16List; //same for uint16
   std::vector<char *> charList; //same for char
-  std::vector<std::function<void(std::vector<uint16_t>)>> funList; //same for function calls
-  std::vector<String> varStack; //objects and arrays store their names in a stack
+  std::vector<std::function<void(const float *, uint8_t)>> funList; //same for function calls
+  std::function<void(JsonObject, JsonObject)> extraFun; //see addExtra
+  char varStack[starJsonDepth][starJsonIdLength + 1]; //objects and arrays store their names in a stack
+  uint8_t varStackDepth = 0; //can be more than starJsonDepth, then the deeper ids are ""
   bool collectNumbers = false; //array can ask to store all numbers found in array (now used for x,y,z coordinates)
-  std::vector<uint16_t> uint16CollectList; //collected numbers
-  char lastVarId[128] = ""; //last found var id in json
-  char beforeLastVarId[128] = ""; //last found var id in json
+  float numbers[starJsonNumbers]; //collected numbers
+  uint8_t numbersCount = 0;
+  char lastVarId[starJsonIdLength + 1] = ""; //last found var id in json
   size_t foundCounter = 0; //count how many of the id's to lookFor have been actually found
   bool foundAll = false;
 
   //called by lookedFor, store the var details in varDetails
-  void addToVars(const char * id, const char * type, size_t index);
+  void addToVars(const char * id, VarType type, size_t index);
+
+  //next character of the file in character, false if end of file
+  bool read() {
+    if (bufferIndex == bufferLength) {
+      int length = f.read(buffer, sizeof(buffer));
+      bufferLength = length > 0?length:0;
+      bufferIndex = 0;
+      if (bufferLength == 0) {
+        endOfFile = true;
+        return false;
+      }
+    }
+    character = buffer[bufferIndex++];
+    return true;
+  }
+
+  const char *varStackId(uint8_t depth) {
+    return depth < starJsonDepth?varStack[depth]:"";
+  }
 
   void next();
 
-  void check(char * varId, char * value = nullptr);
+  void check(const char * varId, const char * value = nullptr);
 
   //writeJsonVariantToFile calls itself recursively until whole json document has been parsed
   void writeJsonVariantToFile(JsonVariant variant);
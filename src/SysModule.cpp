@@ -141,10 +141,10 @@ void SysModule::addPresets(JsonObject parentVar) {
           ppf("save %s.%s: %s\n", variable.pid(), variable.id(), variable.valueString().c_str());
           modulePresets[presetIndex][variable.pid()][variable.id()] = var["value"];
 
-          if (var["type"] == "text") {
+          if (variable.isType("text")) {
             result += variable.valueString().c_str(); //concat
             result.catSep(", ");
-          } else if (var["type"] == "select") {
+          } else if (variable.isType("select")) {
             char option[32];
             if (variable.valIsArray())
               variable.getOption(option, var["value"][0]); //only one for now
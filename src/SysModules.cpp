@@ -111,6 +111,8 @@ void SysModules::setup() {
     variable.triggerEvent(onSetValue);
   });
 
+  mdl->loopTask = xTaskGetCurrentTaskHandle(); //setup runs in the loop task
+  mdl->coalesceChanges = true; //from now on changes are dispatched once per loop
 }
 
 void SysModules::loop() {
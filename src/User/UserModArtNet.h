@@ -32,6 +32,10 @@ public:
 
     const Variable parentVar = ui->initUserMod(Variable(), name, 6100);
 
+    #ifdef STARLIGHT_PIPELINE
+      fix->addFrameOutput([this]() {sendFrame();});
+    #endif
+
     ui->initNumber(parentVar, "targetIP", 11, 0, 255, false, [this](EventArguments) { switch (eventType) {
       case onUI: {
         variable.setComment("IP to send data to");
@@ -63,7 +67,17 @@ public:
   void loop20ms() override {
     // SysModule::loop();
 
-    if(!mdls->isConnected) return;
+    if (fix->pipelined()) return; //the output task sends each frame
+
+    if (fix->frameNr == sentFrameNr) return; //no new frame handed over
+    sentFrameNr = fix->frameNr;
+
+    sendFrame();
+  }
+
+  //send ledsF
+  void sendFrame() {
+    if(!isEnabled || !mdls->isConnected) return;
 
     targetIp[0] = net->localIP()[0];
     targetIp[1] = net->localIP()[1];
@@ -71,8 +85,6 @@ public:
 
     if(!targetIp) return;
 
-    if(!eff->newFrame) return;
-
     uint8_t bri = mdl->linearToLogarithm(fix->bri);
 
     // calculate the number of UDP packets we need to send
@@ -120,7 +132,7 @@ public:
         packet_buffer[17] = packetSize;
 
         // bulk copy the buffer range to the packet buffer after the header 
-        memcpy(packet_buffer+18, (&fix->ledsP[0].r)+bufferOffset, packetSize); //start from the first byte of ledsP[0]
+        memcpy(packet_buffer+18, (&fix->ledsF[0].r)+bufferOffset, packetSize); //start from the first byte of ledsF[0]
 
         for (int i = 18; i < packetSize+18; i+=sizeof(CRGB)) {
           // set brightness all at once - seems slightly faster than scale8()?
@@ -143,10 +155,11 @@ public:
         hardware_output_universe++;
       }
     }
-  } //loop
+  } //sendFrame
 
   private:
     size_t sequenceNumber = 0;
+    uint32_t sentFrameNr = 0;
 
 };
 
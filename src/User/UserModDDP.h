@@ -47,6 +47,10 @@ public:
 
     const Variable parentVar = ui->initUserMod(Variable(), name, 6000);
 
+    #ifdef STARLIGHT_PIPELINE
+      fix->addFrameOutput([this]() {sendFrame();});
+    #endif
+
     ui->initIP(parentVar, "instance", UINT16_MAX, false, [this](EventArguments) { switch (eventType) {
       case onUI: {
         variable.setComment("Instance to send data");
@@ -83,11 +87,19 @@ public:
   void loop() override {
     // SysModule::loop();
 
-    if(!mdls->isConnected) return;
+    if (fix->pipelined()) return; //the output task sends each frame
 
-    if(!targetIp) return;
+    if (fix->frameNr == sentFrameNr) return; //no new frame handed over
+    sentFrameNr = fix->frameNr;
+
+    sendFrame();
+  }
+
+  //send ledsF
+  void sendFrame() {
+    if(!isEnabled || !mdls->isConnected) return;
 
-    if(!eff->newFrame) return;
+    if(!targetIp) return;
 
     // calculate the number of UDP packets we need to send
     bool isRGBW = false;
@@ -140,7 +152,7 @@ public:
       /*9*/ddpUdp.write(0xFF & (packetSize     ));
 
       for (size_t i = 0; i < fix->nrOfLeds; i++) {
-        CRGB pixel = fix->ledsP[i];
+        CRGB pixel = fix->ledsF[i];
         ddpUdp.write(scale8(pixel.r, bri)); // R
         ddpUdp.write(scale8(pixel.g, bri)); // G
         ddpUdp.write(scale8(pixel.b, bri)); // B
@@ -161,6 +173,7 @@ public:
 
   private:
     size_t sequenceNumber = 0;
+    uint32_t sentFrameNr = 0;
 
 };
 
@@ -0,0 +1,178 @@
+/*
+   @title     StarLight
+   @file      HostStubs.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) versions of the system modules which talk to hardware or network
+//Model, UI, Files, StarJson, the Led modules and SysModules are compiled from src as is
+
+#include "SysModule.h"
+#include "SysModules.h"
+#include "Sys/SysModPrint.h"
+#include "Sys/SysModWeb.h"
+#include "Sys/SysModUI.h"
+#include "Sys/SysModSystem.h"
+#include "Sys/SysModFiles.h"
+#include "Sys/SysModModel.h"
+#include "Sys/SysModPins.h"
+#include "Sys/SysModNetwork.h"
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+
+#include "HostStubs.h"
+
+SysModules *mdls;
+SysModPrint *print;
+SysModWeb *web;
+SysModUI *ui;
+SysModSystem *sys;
+SysModFiles *files;
+SysModModel *mdl;
+SysModPins *pinsM;
+SysModNetwork *net;
+LedModFixture *fix;
+LedModEffects *eff;
+
+bool hostVerbose = false;
+
+//Print: stdout only, silent unless hostVerbose (the benchmark output should not drown in mapping logs)
+
+SysModPrint::SysModPrint() :SysModule("Print") {}
+void SysModPrint::setup() {SysModule::setup();}
+void SysModPrint::loop20ms() {setupsDone = true;}
+
+void SysModPrint::printf(const char * format, ...) {
+  if (!hostVerbose) return;
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+}
+
+void SysModPrint::println(const __FlashStringHelper * x) {
+  printf("%s\n", x);
+}
+
+void SysModPrint::printVar(JsonObject var) {
+  printJson("", var);
+}
+
+void SysModPrint::printJson(const char * text, JsonVariantConst source) {
+  if (!hostVerbose) return;
+  char resStr[1024];
+  serializeJson(source, resStr, sizeof(resStr));
+  printf("%s %s\n", text, resStr);
+}
+
+JsonString SysModPrint::fFormat(char * buf, size_t size, const char * format, ...) {
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buf, size, format, args);
+  va_end(args);
+  return JsonString(buf);
+}
+
+void SysModPrint::printJDocInfo(const char * text, JsonDocument source) {
+  printf("%s (s:%u o:%u n:%u)\n", text, source.size(), source.overflowed(), source.nesting());
+}
+
+//Web: no server, responses are collected and dropped every 20ms like after sending
+
+SysModWeb::SysModWeb() :SysModule("Web") {
+  responseDocLoopTask = new JsonDocument; responseDocLoopTask->to<JsonObject>();
+  responseDocAsyncTCP = responseDocLoopTask; //one task on the host
+}
+void SysModWeb::setup() {SysModule::setup();}
+void SysModWeb::loop20ms() {sendResponseObject();}
+void SysModWeb::loop1s() {}
+void SysModWeb::reboot() {}
+void SysModWeb::connectedChanged() {}
+void SysModWeb::sendDataWs(JsonVariant json, WebClient * client) {}
+void SysModWeb::sendDataWs(std::function<void(AsyncWebSocketMessageBuffer *)> fill, size_t len, bool isBinary, WebClient * client) {}
+void SysModWeb::sendBuffer(AsyncWebSocketMessageBuffer * wsBuf, bool isBinary, WebClient * client, bool lossless) {}
+void SysModWeb::clientsToJson(JsonArray array, bool nameOnly, const char * filter) {}
+JsonDocument * SysModWeb::getResponseDoc() {return responseDocLoopTask;}
+JsonObject SysModWeb::getResponseObject() {return getResponseDoc()->as<JsonObject>();}
+void SysModWeb::sendResponseObject(WebClient * client) {
+  if (getResponseObject().size()) getResponseDoc()->to<JsonObject>(); //nobody listening: clear
+}
+
+//System: only the time keeping
+
+SysModSystem::SysModSystem() :SysModule("System") {}
+void SysModSystem::setup() {SysModule::setup();}
+void SysModSystem::loop() {now = millis() - timebase;}
+void SysModSystem::loop10s() {}
+bool SysModSystem::sysTools_normal_startup() {return true;}
+String SysModSystem::sysTools_getRestartReason() {return String("host");}
+
+//Network: not connected, only localIP for the fixture generator
+
+SysModNetwork::SysModNetwork() :SysModule("Network") {}
+void SysModNetwork::setup() {SysModule::setup();}
+void SysModNetwork::loop1s() {}
+void SysModNetwork::loop10s() {}
+IPAddress SysModNetwork::localIP() {return IPAddress(127, 0, 0, 1);}
+
+//Pins: bookkeeping only, nothing to drive
+
+SysModPins::SysModPins() :SysModule("Pins") {
+  for (PinObject &pinObject:pinObjects) {
+    strlcpy(pinObject.owner, "", sizeof(PinObject::owner));
+    strlcpy(pinObject.details, "", sizeof(PinObject::details));
+  }
+}
+void SysModPins::setup() {SysModule::setup();}
+void SysModPins::loop20ms() {}
+
+void SysModPins::allocatePin(uint8_t pin, const char * owner, const char * details) {
+  if (pin < NUM_DIGITAL_PINS) {
+    strlcpy(pinObjects[pin].owner, owner, sizeof(PinObject::owner));
+    strlcpy(pinObjects[pin].details, details, sizeof(PinObject::details));
+    pinsChanged = true;
+  }
+}
+
+void SysModPins::deallocatePin(uint8_t pin, const char * owner) {
+  for (uint8_t p = 0; p < NUM_DIGITAL_PINS; p++) {
+    if ((pin == UINT8_MAX || p == pin) && (owner == nullptr || isOwner(p, owner))) {
+      strlcpy(pinObjects[p].owner, "", sizeof(PinObject::owner));
+      strlcpy(pinObjects[p].details, "", sizeof(PinObject::details));
+      pinsChanged = true;
+    }
+  }
+}
+
+void hostSetup() {
+  //same order as main.cpp, without network, instances and usermods
+  mdls = new SysModules();
+
+  print = new SysModPrint();
+  files = new SysModFiles();
+  mdl = new SysModModel();
+  web = new SysModWeb();
+  ui = new SysModUI();
+  sys = new SysModSystem();
+  pinsM = new SysModPins();
+  net = new SysModNetwork();
+  eff = new LedModEffects();
+  fix = new LedModFixture();
+
+  mdls->add(fix);
+  mdls->add(eff);
+  mdls->add(files);
+  mdls->add(sys);
+  mdls->add(pinsM);
+  mdls->add(print);
+  mdls->add(web);
+  mdls->add(mdl);
+  mdls->add(ui);
+
+  mdls->setup();
+}
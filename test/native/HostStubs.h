@@ -0,0 +1,17 @@
+/*
+   @title     StarLight
+   @file      HostStubs.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+#pragma once
+
+extern bool hostVerbose; //print ppf output to stdout
+
+//create and setup the modules like main.cpp setup() does
+void hostSetup();
@@ -0,0 +1,530 @@
+/*
+   @title     StarLight
+   @file      bench.cpp
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host benchmark of the render core: effect x projection x fixture
+//per combination: mapping time, average frame time and bytes used by the layer
+//  xyz ns: time per XYZ call of the projection
+//  then a remap with the same projection: total time and the longest loop while it runs (the freeze the show sees)
+//  then a blocking mapping restored from the mapping cache (as at boot), map ms is without the cache
+//run: pio run -e native && .pio/build/native/program [fixture=Panel] [effect=Lines] [projection=Default] [frames=100] [buffer] [verbose]
+//  layers=N runs the effect in N layers, the upper ones composed with blend=0..4 (Alpha, Add, Max, Multiply, Screen) and opacity=0..255
+//  load: per fixture the json and the binary fixture (converted by fixtureToBin), load and map time without the mapping cache,
+//    parses of the json: 1 if its header metadata (nrOfLeds, width, height, depth, ledFactor) matches the pixels
+//    generated fixtures and the fixtures in misc/ of the repo (misc=<dir> if not run from the repo root)
+//  gen: per fixture the time to generate it with GenFix and its size
+//  vars: heap used by the default model, ns per findVar of all vars in the model, walking the model and via the var index,
+//    and us per SysModModel::loop1s, for growing model sizes
+//  save: us and bytes written per saveModel with the model journal (a slider dragged between saves) and per full model.json write,
+//    compactions triggered by the journal size and whether a model read at boot (snapshot + journal) has the saved values, also of vars created after the snapshot
+//  changes: per frame of 100 setValues of one slider (as E1.31 or instance sync do), us and onChange calls, coalesced
+//    (dispatched by SysModModel::loop) and synchronous (syncChanges). Other modes set values synchronously
+//  trigo: ns per sinf and per sinQ15 (and its max error), per TiltPanRoll frame matrix and per Trigo::rotate (fixture generator)
+
+#ifndef PIO_UNIT_TESTING
+
+#include "HostStubs.h"
+
+#include "SysModule.h"
+#include "Sys/SysModFiles.h"
+#include "Sys/SysModModel.h"
+#include "Sys/SysModSystem.h"
+#include "Sys/SysModWeb.h"
+#include "Sys/SysModNetwork.h"
+#include "Sys/SysModUI.h"
+#include "Sys/SysModPrint.h"
+#include "App/LedModEffects.h"
+#include "App/LedModFixture.h"
+#include "App/LedModFixtureGen.h"
+
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <malloc.h>
+
+//heap in use (vectors, layers, json, SharedData): the mapping reports its growth
+static size_t heapInUse() {
+  return mallinfo2().uordblks;
+}
+
+struct BenchFixture {
+  const char *name;
+  std::function<void(GenFix &)> gen;
+};
+
+static void genMatrix(GenFix &genFix, uint16_t width, uint16_t height, uint16_t z = 0) {
+  genFix.factor = 1; //1 pixel = 1 unit, as the fixture generator does for matrices
+  genFix.matrix({0, 0, z}, {(uint16_t)(width - 1), 0, z}, {0, (uint16_t)(height - 1), z}, 0, 2); //serpentine
+}
+
+static BenchFixture benchFixtures[] = {
+  {"F_Panel16x16", [](GenFix &genFix) {genMatrix(genFix, 16, 16);}},
+  {"F_Panel128x96", [](GenFix &genFix) {genMatrix(genFix, 128, 96);}},
+  {"F_Panel128x128", [](GenFix &genFix) {genMatrix(genFix, 128, 128);}},
+#if STARLIGHT_MAXLEDS >= 32768
+  {"F_Panel256x128", [](GenFix &genFix) {genMatrix(genFix, 256, 128);}}, //wide PhysMap only
+#endif
+  {"F_Cube202020", [](GenFix &genFix) {for (uint16_t z = 0; z < 20; z++) genMatrix(genFix, 20, 20, z);}},
+  {"F_Rings241", [](GenFix &genFix) {
+    uint8_t radius = 10 * 60 / M_TWOPI; //outer ring in mm, same as the fixture generator
+    genFix.rings241({radius, radius, 0}, 9, true, 0, 2);
+  }},
+};
+
+static const char *argValue(int argc, char **argv, const char *key) {
+  size_t len = strlen(key);
+  for (int i = 1; i < argc; i++)
+    if (strncmp(argv[i], key, len) == 0 && argv[i][len] == '=') return argv[i] + len + 1;
+  return nullptr;
+}
+
+static bool matches(const char *filter, const char *name) {
+  return filter == nullptr || strstr(name, filter) != nullptr;
+}
+
+static void benchTrigo() {
+  const unsigned calls = 1000000;
+  volatile int32_t sink = 0; //so the loops are not optimized away
+
+  int maxError = 0;
+  for (uint32_t angle = 0; angle < 65536; angle++)
+    maxError = max(maxError, abs(sinQ15(angle) - (int)lroundf(sinf(M_TWOPI * angle / 65536) * 32767)));
+
+  unsigned long start = micros();
+  for (unsigned i = 0; i < calls; i++) sink = sink + lroundf(sinf(M_TWOPI * (i % 360) / 360) * 32767);
+  float sinfNs = (micros() - start) * 1000.0f / calls;
+
+  start = micros();
+  for (unsigned i = 0; i < calls; i++) sink = sink + sinQ15(i * 181);
+  float sinQ15Ns = (micros() - start) * 1000.0f / calls;
+
+  PixelTransform transform;
+  start = micros();
+  for (unsigned i = 0; i < calls; i++) {
+    transform.identity();
+    transform.rotate(0, i, 255);
+    transform.rotate(1, i * 2, 255);
+    transform.rotate(2, i * 3, 255);
+    sink = sink + transform.m[0][0];
+  }
+  float matrixNs = (micros() - start) * 1000.0f / calls;
+
+  Trigo trigo;
+  start = micros();
+  for (unsigned i = 0; i < calls; i++) sink = sink + trigo.rotate({(int)(i % 16), (int)(i / 16 % 16), 3}, {8, 8, 8}, i % 360, i * 2 % 360, i * 3 % 360).x;
+  float rotateNs = (micros() - start) * 1000.0f / calls;
+
+  printf("trigo: sinf %.1f ns, sinQ15 %.1f ns (max error %d lsb), frame matrix %.1f ns, Trigo::rotate %.1f ns\n", sinfNs, sinQ15Ns, maxError, matrixNs, rotateNs);
+}
+
+//map the fixture file without the mapping cache, returns ms
+static float benchMapFixture(const char *fileName) {
+  size_t fixtureNr;
+  if (!files->nameToSeqNr(fileName, &fixtureNr, "F_")) return 0;
+  mdl->setValue("Fixture", "fixture", (uint8_t)fixtureNr);
+  web->sendResponseObject(); //drop the ui responses
+  for (LedsLayer *leds: fix->layers) leds->triggerMapping();
+  files->remove(mapCacheFile);
+  fix->mapCacheSignature = 0;
+  unsigned long start = micros();
+  if (fix->mappingStatus == 1) fix->mapInitAlloc();
+  return (micros() - start) / 1000.0f;
+}
+
+static size_t fileSize(const char *fileName) {
+  File f = files->open(fileName, "r");
+  size_t size = f ? f.size() : 0;
+  if (f) f.close();
+  return size;
+}
+
+//copy the fixtures of dir on the host (misc/ of the repo) into the file system, returns their names (without .json)
+static std::vector<std::string> copyHostFixtures(const char *dir) {
+  std::vector<std::string> names;
+  DIR *hostDir = opendir(dir);
+  if (!hostDir) {
+    printf("fixtures dir %s not found\n", dir);
+    return names;
+  }
+  while (dirent *entry = readdir(hostDir)) {
+    std::string name = entry->d_name;
+    if (name.rfind("F_", 0) != 0 || name.size() < 5 || name.compare(name.size() - 5, 5, ".json") != 0) continue;
+    std::ifstream in(std::string(dir) + "/" + name, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    File f = files->open(("/" + name).c_str(), "w");
+    if (!f) continue;
+    f.write((const uint8_t *)content.data(), content.size());
+    f.close();
+    names.push_back(name.substr(0, name.size() - 5));
+  }
+  closedir(hostDir);
+  files->filesChanged = true;
+  return names;
+}
+
+static void benchLoadFixture(const char *name) {
+  char jsonName[32], binName[32];
+  print->fFormat(jsonName, sizeof(jsonName), "/%s.json", name);
+
+  unsigned long start = micros();
+  if (!fix->fixtureToBin(jsonName, binName, sizeof(binName))) {
+    printf("fixture %s not converted\n", name);
+    return;
+  }
+  float convMs = (micros() - start) / 1000.0f;
+  files->filesChanged = true;
+
+  float jsonMs = benchMapFixture(jsonName);
+  uint8_t parses = fix->fixtureParses;
+  Coord3D jsonSize = fix->fixSize;
+  uint16_t jsonLeds = fix->nrOfLeds;
+  std::vector<uint16_t> jsonPixels(fix->pixelCache, fix->pixelCache + fix->pixelCacheSize * 3);
+  float binMs = benchMapFixture(binName);
+  bool same = jsonSize == fix->fixSize && jsonLeds == fix->nrOfLeds && jsonPixels.size() == fix->pixelCacheSize * 3 && std::equal(jsonPixels.begin(), jsonPixels.end(), fix->pixelCache);
+
+  printf("%-18s %6d %10zu %10zu %9.3f %9.3f %7d %9.3f %6s\n", name + 2, jsonLeds, fileSize(jsonName), fileSize(binName), convMs, jsonMs, parses, binMs, same ? "yes" : "no");
+  fflush(stdout);
+}
+
+//generated fixtures and the fixtures in miscDir (as written by hand or by other tools)
+static void benchLoad(const char *fixtureFilter, const char *miscDir) {
+  printf("%-18s %6s %10s %10s %9s %9s %7s %9s %6s\n", "fixture", "leds", "json B", "bin B", "conv ms", "json ms", "parses", "bin ms", "same");
+  for (BenchFixture &benchFixture: benchFixtures)
+    if (matches(fixtureFilter, benchFixture.name)) benchLoadFixture(benchFixture.name);
+  for (const std::string &name: copyHostFixtures(miscDir))
+    if (matches(fixtureFilter, name.c_str())) benchLoadFixture(name.c_str());
+}
+
+//findVar of all vars in the model, walking the model and via the var index, as the model grows
+static void benchVars() {
+  size_t nrOfVars = 0;
+  mdl->walkThroughModel([&nrOfVars](JsonObject, JsonObject) {nrOfVars++; return JsonObject();});
+  printf("default model %zu vars, %zu var metas of %zu B, heap in use %zu B\n", nrOfVars, mdl->varMetas.size(), sizeof(VarMeta), heapInUse());
+
+  //model for the ui: serialized with the metadata (type, ro, min, max) from VarMeta, same as a copy with addVarMetaJson
+  JsonBufferWriter measure;
+  mdl->serializeVars(mdl->model->as<JsonVariant>(), measure);
+  std::string serialized(measure.length, ' ');
+  JsonBufferWriter writer((uint8_t *)&serialized[0], serialized.size());
+  unsigned long start = micros();
+  mdl->serializeVars(mdl->model->as<JsonVariant>(), writer);
+  unsigned long serializeUs = micros() - start;
+  size_t heapBefore = heapInUse();
+  JsonDocument modelDoc(&mdl->allocator);
+  modelDoc.set(mdl->model->as<JsonVariant>());
+  for (JsonObject moduleVar: modelDoc.as<JsonArray>()) mdl->addVarMetaJson(moduleVar);
+  size_t copyBytes = heapInUse() - heapBefore;
+  std::string copied(measureJson(modelDoc.as<JsonVariant>()) + 1, ' ');
+  copied.resize(serializeJson(modelDoc.as<JsonVariant>(), &copied[0], copied.size()));
+  printf("serializeVars %zu B in %lu us, no copy (a copy: %zu B heap), same as the copy: %s\n", serialized.size(), serializeUs, copyBytes, serialized == copied?"yes":"NO");
+
+  //setValue of a slider bound to a value, without event: json value + write through the pointer
+  static uint8_t boundValue = 0;
+  Variable benchVar = mdl->initVar(Variable(), "BenchVars", "module");
+  Variable boundVar = ui->initSlider(benchVar, "bound", &boundValue);
+  start = micros();
+  for (unsigned i = 0; i < 10000; i++) {
+    boundVar.setValue((uint8_t)(i & 0xFF));
+    if (i % 100 == 0) web->sendResponseObject(); //drop the ui responses
+  }
+  printf("setValue bound slider %.1f ns (value %d)\n", (micros() - start) * 1000.0f / 10000, boundValue);
+
+  printf("%8s %10s %10s %10s\n", "vars", "walk ns", "index ns", "loop1s us");
+  for (size_t nrOfVars: {0, 500, 1000, 2000}) {
+    std::vector<std::pair<const char *, const char *>> vars; //pid, id
+    mdl->walkThroughModel([&vars](JsonObject parentVar, JsonObject var) {
+      vars.push_back({var["pid"].as<const char *>(), var["id"].as<const char *>()});
+      return JsonObject(); //don't stop
+    });
+    for (size_t i = vars.size(); i < nrOfVars; i++) { //grow the model
+      char id[32];
+      snprintf(id, sizeof(id), "bench%zu", i);
+      Variable variable = mdl->initVar(benchVar, strdup(id), "number"); //ids are not copied by the model
+      vars.push_back({variable.pid(), variable.id()});
+    }
+
+    volatile size_t found = 0;
+    unsigned long start = micros();
+    for (auto &var: vars) found = found + !mdl->findVarWalk(var.first, var.second).isNull();
+    float walkNs = (micros() - start) * 1000.0f / vars.size();
+
+    for (auto &var: vars) mdl->findVar(var.first, var.second); //all indexed
+    unsigned rounds = 100;
+    start = micros();
+    for (unsigned round = 0; round < rounds; round++)
+      for (auto &var: vars) found = found + !mdl->findVar(var.first, var.second).isNull();
+    float indexNs = (micros() - start) * 1000.0f / (vars.size() * rounds);
+
+    mdl->loop1s(); //first after vars are added
+    start = micros();
+    for (unsigned round = 0; round < rounds; round++) mdl->loop1s();
+    float loop1sUs = (micros() - start) / (float)rounds;
+    web->sendResponseObject(); //drop the ui responses
+
+    printf("%8zu %10.1f %10.1f %10.1f\n", vars.size(), walkNs, indexNs, loop1sUs);
+  }
+}
+
+//saveModel after a slider drag (values coalesced per var): journal append vs full model.json write, then replay as at boot
+static void benchSave() {
+  mdl->writeModel(); //snapshot
+  unsigned long start = micros();
+  mdl->writeModel();
+  float fullUs = micros() - start;
+  size_t fullBytes = fileSize("/model.json");
+
+  printf("%6s %10s %10s %10s %8s\n", "save", "journal us", "bytes", "journal B", "compact");
+  size_t journalSize = 0;
+  uint8_t compactions = 0;
+  for (uint8_t save = 0; save < 120; save++) {
+    for (uint8_t value = 0; value < 50; value++) mdl->setValue("Fixture", "brightness", (uint8_t)(save * 5 + value));
+    if (save % 4 == 0) mdl->setValue("Fixture", "fps", (uint16_t)(50 + save));
+    web->sendResponseObject(); //drop the ui responses
+
+    mdl->doWriteModel = true;
+    start = micros();
+    mdl->loop20ms();
+    float saveUs = micros() - start;
+    size_t newSize = fileSize(modelJournalFile);
+    bool compact = mdl->doCompactModel;
+    if (compact) {
+      mdl->loop20ms(); //compaction in the next loop
+      compactions++;
+    }
+    if (save % 10 == 0 || compact) printf("%6d %10.1f %10zu %10zu %8s\n", save, saveUs, newSize - journalSize, newSize, compact ? "yes" : "");
+    journalSize = fileSize(modelJournalFile);
+  }
+  printf("full model.json write %.1f us %zu bytes, %d compactions\n", fullUs, fullBytes, compactions);
+
+  //a var created after the snapshot: only in the journal
+  Variable benchVar = mdl->initVar(Variable(), "BenchSave", "module");
+  mdl->initVar(benchVar, "late", "number", false).setValue(42);
+  mdl->doWriteModel = true;
+  mdl->loop20ms();
+
+  SysModModel boot; //reads model.json and replays the journal
+  bool same = boot.findVarWalk("Fixture", "brightness")["value"] == mdl->getValue("Fixture", "brightness") && boot.findVarWalk("Fixture", "fps")["value"] == mdl->getValue("Fixture", "fps");
+  printf("boot replay same values: %s\n", same ? "yes" : "no");
+  bool pending = boot.findVarWalk("BenchSave", "late").isNull() && boot.journalVars.size() == 1;
+
+  //initVar of the var takes the journal value (in mdl as initVar works on the model of mdl)
+  mdl->walkThroughModel([](JsonObject parentVar, JsonObject var) {
+    if (var["id"] == "late") parentVar["n"].as<JsonArray>().clear();
+    return JsonObject();
+  });
+  mdl->varsRemoved();
+  mdl->journalVars.set(boot.journalVars.as<JsonVariant>());
+  Variable late = mdl->initVar(benchVar, "late", "number", false);
+  printf("boot replay var not in the snapshot: not created %s, initVar takes the value %s\n", pending ? "yes" : "no", late.var["value"] == 42 && mdl->journalVars.size() == 0 ? "yes" : "no");
+}
+
+//a slider set 100 times per frame, onChange counted: coalesced vs synchronous
+static void benchChanges() {
+  static uint8_t boundValue = 0;
+  static unsigned onChanges = 0;
+  Variable benchVar = mdl->initVar(Variable(), "BenchChanges", "module");
+  Variable slider = ui->initSlider(benchVar, "slider", &boundValue, 0, 255, false, [](EventArguments) { switch (eventType) {
+    case onChange:
+      onChanges++;
+      return true;
+    default: return false;
+  }});
+
+  printf("%-12s %10s %10s %8s %8s\n", "changes", "frame us", "onChange", "value", "stale");
+  for (bool sync: {false, true}) {
+    slider.syncChanges(sync);
+    onChanges = 0;
+    unsigned stale = 0; //bound value not yet the new value right after setValue
+    unsigned frames = 100;
+    unsigned long start = micros();
+    for (unsigned frame = 0; frame < frames; frame++) {
+      for (uint8_t i = 0; i < 100; i++) {
+        slider.setValue((uint8_t)(frame + i));
+        stale += boundValue != (uint8_t)(frame + i);
+      }
+      mdl->loop(); //dispatch
+      web->sendResponseObject(); //drop the ui responses
+    }
+    printf("%-12s %10.1f %10.1f %8d %8u\n", sync ? "synchronous" : "coalesced", (micros() - start) / (float)frames, onChanges / (float)frames, boundValue, stale);
+  }
+}
+
+int main(int argc, char **argv) {
+  const char *fixtureFilter = argValue(argc, argv, "fixture");
+  const char *effectFilter = argValue(argc, argv, "effect");
+  const char *projectionFilter = argValue(argc, argv, "projection");
+  const char *framesArg = argValue(argc, argv, "frames");
+  unsigned frames = framesArg ? strtoul(framesArg, nullptr, 10) : 100;
+  const char *layersArg = argValue(argc, argv, "layers");
+  uint8_t nrOfLayers = layersArg ? constrain(atoi(layersArg), 1, 8) : 1;
+  const char *blendArg = argValue(argc, argv, "blend");
+  const char *opacityArg = argValue(argc, argv, "opacity");
+  const char *miscArg = argValue(argc, argv, "misc");
+  bool virtualBuffer = false;
+  bool load = false;
+  bool gen = false;
+  bool vars = false;
+  bool save = false;
+  bool changes = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "verbose") == 0) hostVerbose = true;
+    if (strcmp(argv[i], "buffer") == 0) virtualBuffer = true; //layers draw in their virtual framebuffer
+    if (strcmp(argv[i], "trigo") == 0) {benchTrigo(); return 0;}
+    if (strcmp(argv[i], "load") == 0) load = true;
+    if (strcmp(argv[i], "gen") == 0) gen = true;
+    if (strcmp(argv[i], "vars") == 0) vars = true;
+    if (strcmp(argv[i], "save") == 0) save = true;
+    if (strcmp(argv[i], "changes") == 0) changes = true;
+  }
+
+  hostSetup();
+  if (changes) {benchChanges(); return 0;}
+  mdl->coalesceChanges = false; //values are set and their result measured right away
+  if (vars) {benchVars(); return 0;}
+  if (save) {benchSave(); return 0;}
+
+  files->removeFiles("F_"); //fixtures from an older run
+  if (gen) printf("%-14s %6s %10s %9s\n", "fixture", "leds", "json B", "gen ms");
+  for (BenchFixture &benchFixture: benchFixtures) {
+    if (!matches(fixtureFilter, benchFixture.name)) continue;
+    unsigned long start = micros();
+    GenFix genFix;
+    genFix.openHeader(benchFixture.name);
+    benchFixture.gen(genFix);
+    genFix.closeHeader();
+    if (gen) {
+      float genMs = (micros() - start) / 1000.0f;
+      char fileName[32];
+      print->fFormat(fileName, sizeof(fileName), "/%s.json", benchFixture.name);
+      printf("%-14s %6d %10zu %9.3f\n", benchFixture.name + 2, genFix.nrOfLeds, fileSize(fileName), genMs);
+    }
+  }
+  if (gen) return 0;
+  files->filesChanged = true;
+
+  //a fresh model holds single values in the layers table, the first setValue with a rowNr clears them so the next ones create the row arrays
+  mdl->setValue("layers", "effect", (uint8_t)0, 0);
+  mdl->setValue("layers", "projection", (uint8_t)0, 0);
+
+  //upper layers: blend mode and opacity (the first layer is composed on black)
+  for (uint8_t rowNr = 0; rowNr < nrOfLayers; rowNr++) {
+    mdl->setValue("layers", "effect", (uint8_t)0, rowNr);
+    mdl->setValue("layers", "projection", (uint8_t)0, rowNr);
+    mdl->setValue("layers", "blend", (uint8_t)(rowNr && blendArg ? atoi(blendArg) : b_alpha), rowNr);
+    mdl->setValue("layers", "opacity", (uint8_t)(rowNr && opacityArg ? atoi(opacityArg) : 255), rowNr);
+  }
+
+  if (load) {benchLoad(fixtureFilter, miscArg ? miscArg : "misc"); return 0;}
+
+  printf("layers %zu\n", fix->layers.size());
+  printf("%-14s %6s %-22s %-22s %9s %10s %8s %7s %9s %9s %9s %10s %8s %8s %10s\n", "fixture", "leds", "effect", "projection", "map ms", "frame us", "fps", "xyz ns", "remap ms", "remap us", "cached ms", "map B", "buf B", "data B", "heap B");
+
+  for (BenchFixture &benchFixture: benchFixtures) {
+    if (!matches(fixtureFilter, benchFixture.name)) continue;
+
+    char fileName[32];
+    print->fFormat(fileName, sizeof(fileName), "/%s.json", benchFixture.name);
+    size_t fixtureNr;
+    if (!files->nameToSeqNr(fileName, &fixtureNr, "F_")) {
+      printf("fixture %s not generated\n", benchFixture.name);
+      continue;
+    }
+    mdl->setValue("Fixture", "fixture", (uint8_t)fixtureNr);
+
+    for (uint8_t projectionNr = 0; projectionNr < eff->projections.size(); projectionNr++) {
+      if (!matches(projectionFilter, eff->projections[projectionNr]->name())) continue;
+
+      for (uint8_t effectNr = 0; effectNr < eff->effects.size(); effectNr++) {
+        if (!matches(effectFilter, eff->effects[effectNr]->name())) continue;
+
+        for (uint8_t rowNr = 0; rowNr < nrOfLayers; rowNr++) {
+          mdl->setValue("layers", "effect", effectNr, rowNr);
+          mdl->setValue("layers", "projection", projectionNr, rowNr);
+        }
+        web->sendResponseObject(); //drop the ui responses
+
+        //force a remap each combination so mapping is measured also if nothing changed
+        for (LedsLayer *leds: fix->layers) {
+          leds->virtualBuffer = virtualBuffer;
+          leds->triggerMapping();
+        }
+
+        files->remove(mapCacheFile); //map ms is parsing the fixture
+        fix->mapCacheSignature = 0;
+
+        size_t heapBefore = heapInUse();
+        unsigned long start = micros();
+        if (fix->mappingStatus == 1) fix->mapInitAlloc();
+        unsigned long mapMicros = micros() - start;
+        long mapHeapBytes = (long)heapInUse() - (long)heapBefore; //negative if the remap frees more than it allocates
+
+        //first frame (effect init) not counted
+        sys->now += 20;
+        eff->loop();
+
+        unsigned long frameMicros = 0;
+        unsigned long frameCounter = eff->frameCounter; //frames rendered, less than loops if a pipelined output is behind
+        for (unsigned frame = 0; frame < frames; frame++) {
+          sys->now += 20; //50 fps effect time
+          start = micros();
+          eff->loop();
+          fix->loop();
+          frameMicros += micros() - start;
+        }
+        //per pixel cost of the projection: XYZ of each virtual pixel, as the effects call it
+        LedsLayer *leds = fix->layers.empty() ? nullptr : fix->layers[0];
+        unsigned long xyzMicros = 0, xyzCalls = 0;
+        volatile int xyzSink = 0;
+        if (leds) {
+          start = micros();
+          for (uint8_t pass = 0; pass < 4; pass++)
+            for (int z = 0; z < leds->size.z; z++) for (int y = 0; y < leds->size.y; y++) for (int x = 0; x < leds->size.x; x++)
+              xyzSink = xyzSink + leds->XYZ(x, y, z);
+          xyzMicros = micros() - start;
+          xyzCalls = 4 * leds->size.x * leds->size.y * leds->size.z;
+        }
+
+        //remap with the same projection (e.g. a projection control changed): in slices while rendering goes on
+        for (LedsLayer *leds: fix->layers) leds->triggerMapping();
+        unsigned long remapMicros = 0, remapLoopMax = 0;
+        while (fix->mappingStatus != 0) {
+          sys->now += 20;
+          start = micros();
+          eff->loop();
+          fix->loop();
+          unsigned long loopMicros = micros() - start;
+          remapMicros += loopMicros;
+          remapLoopMax = max(remapLoopMax, loopMicros);
+        }
+
+        //blocking mapping as at boot: restored from the mapping cache saved by the first mapping
+        for (LedsLayer *leds: fix->layers) leds->triggerMapping();
+        start = micros();
+        fix->mapInitAlloc();
+        unsigned long cachedMicros = micros() - start;
+        web->sendResponseObject();
+
+        frameCounter = eff->frameCounter - frameCounter;
+        float frameAvg = frameCounter ? (float)frameMicros / frameCounter : 0;
+        size_t bufBytes = 0; //all layers
+        for (LedsLayer *leds: fix->layers) bufBytes += leds->ledsVSize * sizeof(CRGB);
+        printf("%-14s %6d %-22.22s %-22.22s %9.3f %10.1f %8.0f %7.1f %9.3f %9lu %9.3f %10zu %8zu %8zu %10ld\n",
+          benchFixture.name + 2, fix->nrOfLeds, eff->effects[effectNr]->name(), eff->projections[projectionNr]->name(),
+          mapMicros / 1000.0f, frameAvg, frameAvg > 0 ? 1000000.0f / frameAvg : 0, xyzCalls ? xyzMicros * 1000.0f / xyzCalls : 0, remapMicros / 1000.0f, remapLoopMax, cachedMicros / 1000.0f,
+          leds ? leds->mappingBytes() : 0, bufBytes, leds ? leds->effectData.bytesAllocated + leds->effectData.blockBytes + leds->projectionData.bytesAllocated + leds->projectionData.blockBytes : 0, mapHeapBytes);
+        fflush(stdout);
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif //PIO_UNIT_TESTING
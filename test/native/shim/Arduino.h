@@ -0,0 +1,300 @@
+/*
+   @title     StarLight
+   @file      Arduino.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) replacement of the Arduino-ESP32 core: only what the render core needs to compile and run on a pc
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cmath>
+#include <cctype>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <type_traits>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word_t;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_dword_near(addr) (*(const uint32_t *)(addr))
+class __FlashStringHelper;
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#ifndef M_TWOPI
+  #define M_TWOPI (M_PI * 2.0)
+#endif
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+//Arduino-ESP32 allows min/max on mixed integer types (e.g. int and size_t)
+template <typename T, typename U> constexpr typename std::common_type<T, U>::type min(const T &a, const U &b) {return (b < a) ? b : a;}
+template <typename T, typename U> constexpr typename std::common_type<T, U>::type max(const T &a, const U &b) {return (a < b) ? b : a;}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long dividend = out_max - out_min;
+  const long divisor = in_max - in_min;
+  if (divisor == 0) return -1; //as Arduino-ESP32
+  return (x - in_min) * dividend / divisor + out_min;
+}
+
+inline uint16_t word(uint8_t h, uint8_t l) {return (h << 8) | l;}
+
+//time: millis/micros count from program start, like on the board
+inline uint64_t nativeMicros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+inline unsigned long millis() {return nativeMicros() / 1000;}
+inline unsigned long micros() {return nativeMicros();}
+inline void delay(uint32_t ms) {std::this_thread::sleep_for(std::chrono::milliseconds(ms));}
+inline void delayMicroseconds(uint32_t us) {std::this_thread::sleep_for(std::chrono::microseconds(us));}
+inline void yield() {}
+
+//random: the no-argument random() is the POSIX one from stdlib
+inline long random(long howbig) {return howbig <= 0 ? 0 : ::random() % howbig;}
+inline long random(long howsmall, long howbig) {return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);}
+inline void randomSeed(unsigned long seed) {if (seed) srandom(seed);}
+
+inline bool isDigit(int c) {return isdigit(c);}
+inline bool isAlpha(int c) {return isalpha(c);}
+inline bool isAlphaNumeric(int c) {return isalnum(c);}
+inline bool isSpace(int c) {return isspace(c);}
+
+//BSD string functions available in newlib but not in glibc
+#if !defined(__APPLE__) && !(defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38)))
+  inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+      size_t n = len < size - 1 ? len : size - 1;
+      memcpy(dst, src, n);
+      dst[n] = '\0';
+    }
+    return len;
+  }
+  inline size_t strlcat(char *dst, const char *src, size_t size) {
+    size_t dlen = strnlen(dst, size);
+    if (dlen == size) return size + strlen(src);
+    return dlen + strlcpy(dst + dlen, src, size - dlen);
+  }
+#endif
+#if !defined(__APPLE__)
+  inline char *strnstr(const char *haystack, const char *needle, size_t len) {
+    size_t nlen = strlen(needle);
+    if (!nlen) return (char *)haystack;
+    for (size_t i = 0; i + nlen <= len && haystack[i]; i++)
+      if (strncmp(haystack + i, needle, nlen) == 0) return (char *)haystack + i;
+    return nullptr;
+  }
+  inline void *reallocf(void *ptr, size_t size) {
+    void *result = realloc(ptr, size);
+    if (!result && size) free(ptr);
+    return result;
+  }
+#endif
+
+//memory: no psram on the host, plain heap instead
+inline bool psramFound() {return false;}
+inline void *ps_malloc(size_t size) {return malloc(size);}
+inline void *ps_calloc(size_t n, size_t size) {return calloc(n, size);}
+inline void *ps_realloc(void *ptr, size_t size) {return realloc(ptr, size);}
+
+class String {
+  std::string s;
+public:
+  String() {}
+  String(const char *c) : s(c ? c : "") {}
+  String(const std::string &c) : s(c) {}
+  String(char c) : s(1, c) {}
+  String(int v) : s(std::to_string(v)) {}
+  String(unsigned v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+  String(float v, unsigned decimals = 2) {char buf[32]; snprintf(buf, sizeof(buf), "%.*f", decimals, v); s = buf;}
+  String(double v, unsigned decimals = 2) {char buf[32]; snprintf(buf, sizeof(buf), "%.*f", decimals, v); s = buf;}
+
+  const char *c_str() const {return s.c_str();}
+  size_t length() const {return s.length();}
+  bool isEmpty() const {return s.empty();}
+  char charAt(size_t i) const {return i < s.length() ? s[i] : 0;}
+  char operator[](size_t i) const {return charAt(i);}
+  void reserve(size_t size) {s.reserve(size);}
+  long toInt() const {return atol(s.c_str());}
+  float toFloat() const {return atof(s.c_str());}
+  int indexOf(char c, size_t from = 0) const {size_t p = s.find(c, from); return p == std::string::npos ? -1 : p;}
+  int indexOf(const char *c, size_t from = 0) const {size_t p = s.find(c, from); return p == std::string::npos ? -1 : p;}
+  String substring(size_t from, size_t to = std::string::npos) const {return from < s.length() ? String(s.substr(from, to == std::string::npos ? to : to - from)) : String();}
+  bool startsWith(const String &o) const {return s.rfind(o.s, 0) == 0;}
+  bool endsWith(const String &o) const {return s.size() >= o.s.size() && s.compare(s.size() - o.s.size(), o.s.size(), o.s) == 0;}
+  void toLowerCase() {for (char &c : s) c = tolower(c);}
+  void toUpperCase() {for (char &c : s) c = toupper(c);}
+  void trim() {while (!s.empty() && isspace(s.back())) s.pop_back(); size_t i = 0; while (i < s.size() && isspace(s[i])) i++; s.erase(0, i);}
+
+  bool concat(const String &o) {s += o.s; return true;}
+  bool concat(const char *c) {if (c) s += c; return true;}
+  bool concat(char c) {s += c; return true;}
+  bool concat(int v) {s += std::to_string(v); return true;}
+  bool concat(unsigned v) {s += std::to_string(v); return true;}
+  bool concat(long v) {s += std::to_string(v); return true;}
+  bool concat(unsigned long v) {s += std::to_string(v); return true;}
+  template <typename T> String &operator+=(const T &v) {concat(v); return *this;}
+
+  bool operator==(const String &o) const {return s == o.s;}
+  bool operator==(const char *c) const {return s == (c ? c : "");}
+  bool operator!=(const String &o) const {return s != o.s;}
+  bool operator!=(const char *c) const {return !(*this == c);}
+  bool operator<(const String &o) const {return s < o.s;}
+  explicit operator bool() const {return true;}
+
+  //ArduinoJson writer/reader interface
+  size_t write(uint8_t c) {s += (char)c; return 1;}
+  size_t write(const uint8_t *buf, size_t size) {s.append((const char *)buf, size); return size;}
+};
+inline String operator+(const String &a, const String &b) {String r(a); r.concat(b); return r;}
+inline String operator+(const String &a, const char *b) {String r(a); r.concat(b); return r;}
+inline String operator+(const char *a, const String &b) {String r(a); r.concat(b); return r;}
+
+class IPAddress {
+  uint8_t bytes[4] = {0, 0, 0, 0};
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {bytes[0] = a; bytes[1] = b; bytes[2] = c; bytes[3] = d;}
+  IPAddress(uint32_t address) {memcpy(bytes, &address, 4);}
+  operator uint32_t() const {uint32_t a; memcpy(&a, bytes, 4); return a;}
+  uint8_t operator[](int i) const {return bytes[i];}
+  uint8_t &operator[](int i) {return bytes[i];}
+  bool operator==(const IPAddress &o) const {return memcmp(bytes, o.bytes, 4) == 0;}
+  String toString() const {char buf[16]; snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]); return String(buf);}
+};
+
+//FreeRTOS: tasks are std::threads (the core is ignored), mutexes are std::timed_mutex
+typedef void *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (ms)
+typedef void (*TaskFunction_t)(void *);
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {return new std::timed_mutex();}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks) {
+  if (!mutex) return pdTRUE;
+  if (ticks == portMAX_DELAY) {((std::timed_mutex *)mutex)->lock(); return pdTRUE;}
+  return ((std::timed_mutex *)mutex)->try_lock_for(std::chrono::milliseconds(ticks))?pdTRUE:pdFALSE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) {if (mutex) ((std::timed_mutex *)mutex)->unlock(); return pdTRUE;}
+inline void vTaskDelay(TickType_t ticks) {delay(ticks);}
+struct HostTask {
+  std::mutex mutex;
+  std::condition_variable notify;
+  uint32_t notified = 0;
+};
+inline HostTask *&hostCurrentTask() {static thread_local HostTask *task = nullptr; return task;}
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *, uint32_t, void *parameter, int, TaskHandle_t *handle, int) {
+  HostTask *task = new HostTask();
+  if (handle) *handle = task;
+  std::thread([task, function, parameter]() {hostCurrentTask() = task; function(parameter);}).detach();
+  return pdPASS;
+}
+inline void xTaskNotifyGive(TaskHandle_t handle) {
+  HostTask *task = (HostTask *)handle;
+  {std::lock_guard<std::mutex> lock(task->mutex); task->notified++;}
+  task->notify.notify_one();
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask *task = hostCurrentTask();
+  if (!task) {delay(ticks); return 0;}
+  std::unique_lock<std::mutex> lock(task->mutex);
+  task->notify.wait_for(lock, std::chrono::milliseconds(ticks), [task]() {return task->notified > 0;});
+  uint32_t value = task->notified;
+  if (value) task->notified = clearOnExit?0:value - 1;
+  return value;
+}
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {return hostCurrentTask();} //nullptr in the main (loop) task
+inline const char *pcTaskGetTaskName(TaskHandle_t) {return "loopTask";}
+inline int xPortGetCoreID() {return 1;}
+
+typedef enum {
+  ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO
+} esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() {return ESP_RST_POWERON;}
+
+class EspClass {
+public:
+  //cycles of a 240MHz core, derived from the host clock so cycle based timing code keeps working
+  uint32_t getCycleCount() {return (uint32_t)(nativeMicros() * 240);}
+  uint32_t getCpuFreqMHz() {return 240;}
+  uint32_t getHeapSize() {return 320 * 1024;}
+  uint32_t getFreeHeap() {return 200 * 1024;}
+  uint32_t getMinFreeHeap() {return 200 * 1024;}
+  uint32_t getMaxAllocHeap() {return 100 * 1024;}
+  uint32_t getPsramSize() {return 0;}
+  uint32_t getFreePsram() {return 0;}
+  uint32_t getMinFreePsram() {return 0;}
+  uint32_t getMaxAllocPsram() {return 0;}
+  uint32_t getFlashChipSize() {return 4 * 1024 * 1024;}
+  uint32_t getSketchSize() {return 0;}
+  const char *getChipModel() {return "native";}
+  uint8_t getChipRevision() {return 0;}
+  uint8_t getChipCores() {return 2;}
+  const char *getSdkVersion() {return "native";}
+  void restart() {exit(0);}
+};
+inline EspClass ESP;
+
+//pins: there are no pins on the host, all are valid so pin allocation code runs unchanged
+#define NUM_DIGITAL_PINS 49
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+inline bool digitalPinIsValid(uint8_t pin) {return pin < NUM_DIGITAL_PINS;}
+inline bool digitalPinCanOutput(uint8_t pin) {return pin < NUM_DIGITAL_PINS;}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) {return LOW;}
+inline uint16_t analogRead(uint8_t) {return 0;}
+
+#include "HardwareSerial.h"
@@ -0,0 +1,23 @@
+/*
+   @title     StarLight
+   @file      DNSServer.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) replacement of DNSServer: SysModNetwork.h holds one, never started on the host
+
+#pragma once
+
+#include <Arduino.h>
+
+class DNSServer {
+public:
+  bool start(uint16_t, const char *, const IPAddress &) {return true;}
+  void stop() {}
+  void processNextRequest() {}
+};
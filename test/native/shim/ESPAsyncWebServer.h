@@ -0,0 +1,77 @@
+/*
+   @title     StarLight
+   @file      ESPAsyncWebServer.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) replacement of ESPAsyncWebServer: the types SysModWeb.h needs, never any client connected
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+typedef enum {WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA} AwsEventType;
+typedef enum {WS_DISCONNECTED, WS_CONNECTED, WS_DISCONNECTING} AwsClientStatus;
+
+class AsyncWebSocket;
+
+class AsyncWebSocketMessageBuffer {
+  std::vector<uint8_t> data;
+public:
+  explicit AsyncWebSocketMessageBuffer(size_t size) : data(size) {}
+  uint8_t *get() {return data.data();}
+  size_t length() const {return data.size();}
+  void lock() {}
+  void unlock() {}
+};
+
+class AsyncWebSocketClient {
+public:
+  uint32_t id() const {return 0;}
+  IPAddress remoteIP() const {return IPAddress();}
+  bool queueIsFull() const {return false;}
+  size_t queueLen() const {return 0;}
+  AwsClientStatus status() const {return WS_DISCONNECTED;}
+  AsyncWebSocket *server() const {return nullptr;}
+  void text(const char *, size_t = 0) {}
+  void binary(AsyncWebSocketMessageBuffer *) {}
+};
+
+//same shape as the LinkedList of AsyncTCP: length() and range for
+class AsyncWebSocketClientList {
+  std::vector<AsyncWebSocketClient *> clients;
+public:
+  size_t length() const {return clients.size();}
+  std::vector<AsyncWebSocketClient *>::iterator begin() {return clients.begin();}
+  std::vector<AsyncWebSocketClient *>::iterator end() {return clients.end();}
+};
+
+class AsyncWebSocket {
+  AsyncWebSocketClientList clients;
+public:
+  explicit AsyncWebSocket(const char *) {}
+  AsyncWebSocketClientList &getClients() {return clients;}
+  size_t count() const {return 0;}
+  AsyncWebSocketMessageBuffer *makeBuffer(size_t) {return nullptr;} //no clients, nothing to send
+  void _cleanBuffers() {}
+  void cleanupClients() {}
+  void textAll(const char *, size_t = 0) {}
+  void binaryAll(AsyncWebSocketMessageBuffer *) {}
+};
+
+class AsyncWebServerRequest {};
+class AsyncWebServerResponse {};
+
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t) {}
+  void begin() {}
+  void end() {}
+};
@@ -0,0 +1,641 @@
+/*
+   @title     StarLight
+   @file      FastLED.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) subset of FastLED 3.7.8: colors, palettes, lib8tion math, noise and random
+//the math follows the FastLED C implementations (FASTLED_SCALE8_FIXED=1) so effects render and cost about the same as on the board
+//there are no controllers: FastLED.show() does nothing
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+typedef int16_t saccum78;
+
+#define GET_MILLIS millis
+
+//lib8tion: scaling and saturating math
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;}
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);}
+inline uint16_t scale16(uint16_t i, fract16 scale) {return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16;}
+inline uint16_t scale16by8(uint16_t i, fract8 scale) {return (i * (1 + ((uint16_t)scale))) >> 8;}
+inline void nscale8x3(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale) {
+  uint16_t scale_fixed = scale + 1;
+  r = (r * scale_fixed) >> 8;
+  g = (g * scale_fixed) >> 8;
+  b = (b * scale_fixed) >> 8;
+}
+inline void nscale8x3_video(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale) {
+  uint8_t nonzeroscale = (scale != 0) ? 1 : 0;
+  r = (r == 0) ? 0 : (((int)r * (int)scale) >> 8) + nonzeroscale;
+  g = (g == 0) ? 0 : (((int)g * (int)scale) >> 8) + nonzeroscale;
+  b = (b == 0) ? 0 : (((int)b * (int)scale) >> 8) + nonzeroscale;
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {unsigned t = i + j; return t > 255 ? 255 : t;}
+inline uint8_t qsub8(uint8_t i, uint8_t j) {int t = i - j; return t < 0 ? 0 : t;}
+inline uint8_t qmul8(uint8_t i, uint8_t j) {unsigned p = (unsigned)i * j; return p > 255 ? 255 : p;}
+inline uint8_t add8(uint8_t i, uint8_t j) {return i + j;}
+inline uint8_t sub8(uint8_t i, uint8_t j) {return i - j;}
+inline uint8_t mul8(uint8_t i, uint8_t j) {return ((int)i * (int)j) & 0xFF;}
+inline uint8_t avg8(uint8_t i, uint8_t j) {return (i + j) >> 1;}
+inline uint16_t avg16(uint16_t i, uint16_t j) {return (uint32_t)((uint32_t)(i) + (uint32_t)(j)) >> 1;}
+inline int8_t avg7(int8_t i, int8_t j) {return (i >> 1) + (j >> 1) + (i & 0x1);}
+inline int16_t avg15(int16_t i, int16_t j) {return (i >> 1) + (j >> 1) + (i & 0x1);}
+inline uint8_t abs8(int8_t i) {return i < 0 ? -i : i;}
+inline uint8_t dim8_raw(uint8_t x) {return scale8(x, x);}
+inline uint8_t dim8_video(uint8_t x) {return scale8_video(x, x);}
+inline uint8_t brighten8_raw(uint8_t x) {uint8_t ix = 255 - x; return 255 - scale8(ix, ix);}
+inline uint8_t brighten8_video(uint8_t x) {uint8_t ix = 255 - x; return 255 - scale8_video(ix, ix);}
+inline uint8_t map8(uint8_t in, uint8_t rangeStart, uint8_t rangeEnd) {return rangeStart + scale8(in, rangeEnd - rangeStart);}
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+  if (b > a) return a + scale8(b - a, frac);
+  else return a - scale8(a - b, frac);
+}
+inline uint16_t lerp16by16(uint16_t a, uint16_t b, fract16 frac) {
+  if (b > a) return a + scale16(b - a, frac);
+  else return a - scale16(a - b, frac);
+}
+inline int16_t lerp15by16(int16_t a, int16_t b, fract16 frac) {
+  if (b > a) return a + scale16(b - a, frac);
+  else return a - scale16(a - b, frac);
+}
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+  uint16_t partial = (a << 8) | b;
+  partial += (b * amountOfB);
+  partial -= (a * amountOfB);
+  return partial >> 8;
+}
+inline uint8_t ease8InOutQuad(uint8_t i) {
+  uint8_t j = i;
+  if (j & 0x80) j = 255 - j;
+  uint8_t jj2 = scale8(j, j) << 1;
+  if (i & 0x80) jj2 = 255 - jj2;
+  return jj2;
+}
+inline uint16_t ease16InOutQuad(uint16_t i) {
+  uint16_t j = i;
+  if (j & 0x8000) j = 65535 - j;
+  uint16_t jj2 = scale16(j, j) << 1;
+  if (i & 0x8000) jj2 = 65535 - jj2;
+  return jj2;
+}
+inline fract8 ease8InOutCubic(fract8 i) {
+  uint8_t ii = scale8(i, i);
+  uint8_t iii = scale8(ii, i);
+  uint16_t r1 = (3 * (uint16_t)ii) - (2 * (uint16_t)iii);
+  return (r1 & 0x100) ? 255 : r1;
+}
+inline uint8_t triwave8(uint8_t in) {if (in & 0x80) in = 255 - in; return in << 1;}
+inline uint8_t quadwave8(uint8_t in) {return ease8InOutQuad(triwave8(in));}
+inline uint8_t cubicwave8(uint8_t in) {return ease8InOutCubic(triwave8(in));}
+inline uint8_t sqrt16(uint16_t x) {
+  if (x <= 1) return x;
+  uint8_t low = 1;
+  uint8_t hi = x > 7904 ? 255 : (x >> 5) + 8;
+  do {
+    uint16_t mid = (low + hi) >> 1;
+    if ((uint16_t)(mid * mid) > x) hi = mid - 1;
+    else {
+      if (mid == 255) return 255;
+      low = mid + 1;
+    }
+  } while (hi >= low);
+  return low - 1;
+}
+
+//lib8tion: trigonometry
+
+inline int16_t sin16(uint16_t theta) {
+  static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+  static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+  uint16_t offset = (theta & 0x3FFF) >> 3; //0..2047
+  if (theta & 0x4000) offset = 2047 - offset;
+  uint8_t section = offset / 256; //0..7
+  uint16_t b = base[section];
+  uint8_t m = slope[section];
+  uint8_t secoffset8 = (uint8_t)(offset) / 2;
+  uint16_t mx = m * secoffset8;
+  int16_t y = mx + b;
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+inline int16_t cos16(uint16_t theta) {return sin16(theta + 16384);}
+
+inline uint8_t sin8(uint8_t theta) {
+  static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = (uint8_t)255 - offset;
+  offset &= 0x3F; //0..63
+  uint8_t secoffset = offset & 0x0F; //0..15
+  if (theta & 0x40) ++secoffset;
+  uint8_t section = offset >> 4; //0..3
+  const uint8_t *p = b_m16_interleave + section * 2;
+  uint8_t b = p[0];
+  uint8_t m16 = p[1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+inline uint8_t cos8(uint8_t theta) {return sin8(theta + 64);}
+
+//lib8tion: random
+
+#define FASTLED_RAND16_2053 ((uint16_t)(2053))
+#define FASTLED_RAND16_13849 ((uint16_t)(13849))
+inline uint16_t rand16seed = 1337;
+inline uint8_t random8() {
+  rand16seed = (rand16seed * FASTLED_RAND16_2053) + FASTLED_RAND16_13849;
+  return (uint8_t)(((uint8_t)(rand16seed & 0xFF)) + ((uint8_t)(rand16seed >> 8)));
+}
+inline uint16_t random16() {
+  rand16seed = (rand16seed * FASTLED_RAND16_2053) + FASTLED_RAND16_13849;
+  return rand16seed;
+}
+inline uint8_t random8(uint8_t lim) {return (random8() * lim) >> 8;}
+inline uint8_t random8(uint8_t min, uint8_t lim) {return random8(lim - min) + min;}
+inline uint16_t random16(uint16_t lim) {return ((uint32_t)lim * (uint32_t)random16()) >> 16;}
+inline uint16_t random16(uint16_t min, uint16_t lim) {return random16(lim - min) + min;}
+inline void random16_set_seed(uint16_t seed) {rand16seed = seed;}
+inline uint16_t random16_get_seed() {return rand16seed;}
+inline void random16_add_entropy(uint16_t entropy) {rand16seed += entropy;}
+
+//lib8tion: beats, based on millis like on the board
+
+inline uint16_t beat88(accum88 beats_per_minute_88, uint32_t timebase = 0) {return (((GET_MILLIS()) - timebase) * beats_per_minute_88 * 280) >> 16;}
+inline uint16_t beat16(accum88 beats_per_minute, uint32_t timebase = 0) {
+  if (beats_per_minute < 256) beats_per_minute <<= 8;
+  return beat88(beats_per_minute, timebase);
+}
+inline uint8_t beat8(accum88 beats_per_minute, uint32_t timebase = 0) {return beat16(beats_per_minute, timebase) >> 8;}
+inline uint16_t beatsin88(accum88 beats_per_minute_88, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0) {
+  uint16_t beat = beat88(beats_per_minute_88, timebase);
+  uint16_t beatsin = (sin16(beat + phase_offset) + 32768);
+  return lowest + scale16(beatsin, highest - lowest);
+}
+inline uint16_t beatsin16(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0) {
+  uint16_t beat = beat16(beats_per_minute, timebase);
+  uint16_t beatsin = (sin16(beat + phase_offset) + 32768);
+  return lowest + scale16(beatsin, highest - lowest);
+}
+inline uint8_t beatsin8(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase_offset = 0) {
+  uint8_t beat = beat8(beats_per_minute, timebase);
+  uint8_t beatsin = sin8(beat + phase_offset);
+  return lowest + scale8(beatsin, highest - lowest);
+}
+
+//noise: Perlin noise as in FastLED noise.cpp
+
+inline const uint8_t fastled_noise_p[] = {
+  151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
+  247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,88,237,149,56,87,174,20,125,136,171,168,68,175,
+  74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,60,211,133,230,220,105,92,41,55,46,245,40,244,102,143,54,
+  65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,
+  52,217,226,250,124,123,5,202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,
+  119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,
+  218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
+  184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
+  151
+};
+#define NOISE_P(x) fastled_noise_p[(x) & 0xFF]
+
+inline int16_t grad16(uint8_t hash, int16_t x, int16_t y, int16_t z) {
+  hash = hash & 15;
+  int16_t u = hash < 8 ? x : y;
+  int16_t v = hash < 4 ? y : hash == 12 || hash == 14 ? x : z;
+  if (hash & 1) u = -u;
+  if (hash & 2) v = -v;
+  return avg15(u, v);
+}
+
+inline int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z) {
+  //find the unit cube containing the point
+  uint8_t X = (x >> 16) & 0xFF;
+  uint8_t Y = (y >> 16) & 0xFF;
+  uint8_t Z = (z >> 16) & 0xFF;
+
+  //hash cube corner coordinates
+  uint8_t A = NOISE_P(X) + Y;
+  uint8_t AA = NOISE_P(A) + Z;
+  uint8_t AB = NOISE_P(A + 1) + Z;
+  uint8_t B = NOISE_P(X + 1) + Y;
+  uint8_t BA = NOISE_P(B) + Z;
+  uint8_t BB = NOISE_P(B + 1) + Z;
+
+  //get the relative position of the point in the cube
+  uint16_t u = x & 0xFFFF;
+  uint16_t v = y & 0xFFFF;
+  uint16_t w = z & 0xFFFF;
+
+  //get a signed version of the above for the grad function
+  int16_t xx = (u >> 1) & 0x7FFF;
+  int16_t yy = (v >> 1) & 0x7FFF;
+  int16_t zz = (w >> 1) & 0x7FFF;
+  uint16_t N = 0x8000L;
+
+  u = ease16InOutQuad(u); v = ease16InOutQuad(v); w = ease16InOutQuad(w);
+
+  int16_t X1 = lerp15by16(grad16(NOISE_P(AA), xx, yy, zz), grad16(NOISE_P(BA), xx - N, yy, zz), u);
+  int16_t X2 = lerp15by16(grad16(NOISE_P(AB), xx, yy - N, zz), grad16(NOISE_P(BB), xx - N, yy - N, zz), u);
+  int16_t X3 = lerp15by16(grad16(NOISE_P(AA + 1), xx, yy, zz - N), grad16(NOISE_P(BA + 1), xx - N, yy, zz - N), u);
+  int16_t X4 = lerp15by16(grad16(NOISE_P(AB + 1), xx, yy - N, zz - N), grad16(NOISE_P(BB + 1), xx - N, yy - N, zz - N), u);
+
+  int16_t Y1 = lerp15by16(X1, X2, v);
+  int16_t Y2 = lerp15by16(X3, X4, v);
+
+  return lerp15by16(Y1, Y2, w);
+}
+inline uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z) {
+  int32_t ans = inoise16_raw(x, y, z);
+  ans = ans + 19052L;
+  uint32_t pan = ans;
+  //pan = (ans * 220L) >> 7, in two steps to stay in 32 bits
+  pan *= 440L;
+  return (pan >> 8);
+}
+inline uint16_t inoise16(uint32_t x, uint32_t y) {return inoise16(x, y, 0);}
+inline uint16_t inoise16(uint32_t x) {return inoise16(x, 0, 0);}
+inline uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {return inoise16((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8) >> 8;}
+inline uint8_t inoise8(uint16_t x, uint16_t y) {return inoise8(x, y, 0);}
+inline uint8_t inoise8(uint16_t x) {return inoise8(x, 0, 0);}
+
+//colors
+
+struct CRGB;
+struct CHSV;
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+
+struct CHSV {
+  union {
+    struct {
+      union {uint8_t hue; uint8_t h;};
+      union {uint8_t saturation; uint8_t sat; uint8_t s;};
+      union {uint8_t value; uint8_t val; uint8_t v;};
+    };
+    uint8_t raw[3];
+  };
+  CHSV() : h(0), s(0), v(0) {}
+  constexpr CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+  uint8_t &operator[](uint8_t x) {return raw[x];}
+  const uint8_t &operator[](uint8_t x) const {return raw[x];}
+  CHSV &setHSV(uint8_t ih, uint8_t is, uint8_t iv) {h = ih; s = is; v = iv; return *this;}
+};
+
+struct CRGB {
+  union {
+    struct {
+      union {uint8_t r; uint8_t red;};
+      union {uint8_t g; uint8_t green;};
+      union {uint8_t b; uint8_t blue;};
+    };
+    uint8_t raw[3];
+  };
+
+  typedef enum {
+    AliceBlue = 0xF0F8FF, Amethyst = 0x9966CC, AntiqueWhite = 0xFAEBD7, Aqua = 0x00FFFF, Aquamarine = 0x7FFFD4, Azure = 0xF0FFFF,
+    Beige = 0xF5F5DC, Bisque = 0xFFE4C4, Black = 0x000000, BlanchedAlmond = 0xFFEBCD, Blue = 0x0000FF, BlueViolet = 0x8A2BE2,
+    Brown = 0xA52A2A, BurlyWood = 0xDEB887, CadetBlue = 0x5F9EA0, Chartreuse = 0x7FFF00, Chocolate = 0xD2691E, Coral = 0xFF7F50,
+    CornflowerBlue = 0x6495ED, Cornsilk = 0xFFF8DC, Crimson = 0xDC143C, Cyan = 0x00FFFF, DarkBlue = 0x00008B, DarkCyan = 0x008B8B,
+    DarkGoldenrod = 0xB8860B, DarkGray = 0xA9A9A9, DarkGrey = 0xA9A9A9, DarkGreen = 0x006400, DarkKhaki = 0xBDB76B, DarkMagenta = 0x8B008B,
+    DarkOliveGreen = 0x556B2F, DarkOrange = 0xFF8C00, DarkOrchid = 0x9932CC, DarkRed = 0x8B0000, DarkSalmon = 0xE9967A, DarkSeaGreen = 0x8FBC8F,
+    DarkSlateBlue = 0x483D8B, DarkSlateGray = 0x2F4F4F, DarkSlateGrey = 0x2F4F4F, DarkTurquoise = 0x00CED1, DarkViolet = 0x9400D3, DeepPink = 0xFF1493,
+    DeepSkyBlue = 0x00BFFF, DimGray = 0x696969, DimGrey = 0x696969, DodgerBlue = 0x1E90FF, FireBrick = 0xB22222, FloralWhite = 0xFFFAF0,
+    ForestGreen = 0x228B22, Fuchsia = 0xFF00FF, Gainsboro = 0xDCDCDC, GhostWhite = 0xF8F8FF, Gold = 0xFFD700, Goldenrod = 0xDAA520,
+    Gray = 0x808080, Grey = 0x808080, Green = 0x008000, GreenYellow = 0xADFF2F, Honeydew = 0xF0FFF0, HotPink = 0xFF69B4,
+    IndianRed = 0xCD5C5C, Indigo = 0x4B0082, Ivory = 0xFFFFF0, Khaki = 0xF0E68C, Lavender = 0xE6E6FA, LavenderBlush = 0xFFF0F5,
+    LawnGreen = 0x7CFC00, LemonChiffon = 0xFFFACD, LightBlue = 0xADD8E6, LightCoral = 0xF08080, LightCyan = 0xE0FFFF, LightGoldenrodYellow = 0xFAFAD2,
+    LightGreen = 0x90EE90, LightGrey = 0xD3D3D3, LightPink = 0xFFB6C1, LightSalmon = 0xFFA07A, LightSeaGreen = 0x20B2AA, LightSkyBlue = 0x87CEFA,
+    LightSlateGray = 0x778899, LightSlateGrey = 0x778899, LightSteelBlue = 0xB0C4DE, LightYellow = 0xFFFFE0, Lime = 0x00FF00, LimeGreen = 0x32CD32,
+    Linen = 0xFAF0E6, Magenta = 0xFF00FF, Maroon = 0x800000, MediumAquamarine = 0x66CDAA, MediumBlue = 0x0000CD, MediumOrchid = 0xBA55D3,
+    MediumPurple = 0x9370DB, MediumSeaGreen = 0x3CB371, MediumSlateBlue = 0x7B68EE, MediumSpringGreen = 0x00FA9A, MediumTurquoise = 0x48D1CC, MediumVioletRed = 0xC71585,
+    MidnightBlue = 0x191970, MintCream = 0xF5FFFA, MistyRose = 0xFFE4E1, Moccasin = 0xFFE4B5, NavajoWhite = 0xFFDEAD, Navy = 0x000080,
+    OldLace = 0xFDF5E6, Olive = 0x808000, OliveDrab = 0x6B8E23, Orange = 0xFFA500, OrangeRed = 0xFF4500, Orchid = 0xDA70D6,
+    PaleGoldenrod = 0xEEE8AA, PaleGreen = 0x98FB98, PaleTurquoise = 0xAFEEEE, PaleVioletRed = 0xDB7093, PapayaWhip = 0xFFEFD5, PeachPuff = 0xFFDAB9,
+    Peru = 0xCD853F, Pink = 0xFFC0CB, Plaid = 0xCC5533, Plum = 0xDDA0DD, PowderBlue = 0xB0E0E6, Purple = 0x800080,
+    Red = 0xFF0000, RosyBrown = 0xBC8F8F, RoyalBlue = 0x4169E1, SaddleBrown = 0x8B4513, Salmon = 0xFA8072, SandyBrown = 0xF4A460,
+    SeaGreen = 0x2E8B57, Seashell = 0xFFF5EE, Sienna = 0xA0522D, Silver = 0xC0C0C0, SkyBlue = 0x87CEEB, SlateBlue = 0x6A5ACD,
+    SlateGray = 0x708090, SlateGrey = 0x708090, Snow = 0xFFFAFA, SpringGreen = 0x00FF7F, SteelBlue = 0x4682B4, Tan = 0xD2B48C,
+    Teal = 0x008080, Thistle = 0xD8BFD8, Tomato = 0xFF6347, Turquoise = 0x40E0D0, Violet = 0xEE82EE, Wheat = 0xF5DEB3,
+    White = 0xFFFFFF, WhiteSmoke = 0xF5F5F5, Yellow = 0xFFFF00, YellowGreen = 0x9ACD32,
+    FairyLight = 0xFFE42D, FairyLightNCC = 0xFF9D2A
+  } HTMLColorCode;
+
+  CRGB() : r(0), g(0), b(0) {}
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+  constexpr CRGB(HTMLColorCode colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+  CRGB(const CHSV &rhs) {hsv2rgb_rainbow(rhs, *this);}
+
+  CRGB &operator=(const CHSV &rhs) {hsv2rgb_rainbow(rhs, *this); return *this;}
+  CRGB &operator=(const uint32_t colorcode) {r = (colorcode >> 16) & 0xFF; g = (colorcode >> 8) & 0xFF; b = (colorcode >> 0) & 0xFF; return *this;}
+  uint8_t &operator[](uint8_t x) {return raw[x];}
+  const uint8_t &operator[](uint8_t x) const {return raw[x];}
+
+  CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb) {r = nr; g = ng; b = nb; return *this;}
+  CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val) {hsv2rgb_rainbow(CHSV(hue, sat, val), *this); return *this;}
+  CRGB &setHue(uint8_t hue) {hsv2rgb_rainbow(CHSV(hue, 255, 255), *this); return *this;}
+  CRGB &setColorCode(uint32_t colorcode) {return *this = colorcode;}
+
+  CRGB &operator+=(const CRGB &rhs) {r = qadd8(r, rhs.r); g = qadd8(g, rhs.g); b = qadd8(b, rhs.b); return *this;}
+  CRGB &addToRGB(uint8_t d) {r = qadd8(r, d); g = qadd8(g, d); b = qadd8(b, d); return *this;}
+  CRGB &operator-=(const CRGB &rhs) {r = qsub8(r, rhs.r); g = qsub8(g, rhs.g); b = qsub8(b, rhs.b); return *this;}
+  CRGB &subtractFromRGB(uint8_t d) {r = qsub8(r, d); g = qsub8(g, d); b = qsub8(b, d); return *this;}
+  CRGB &operator--() {subtractFromRGB(1); return *this;}
+  CRGB operator--(int) {CRGB retval(*this); --(*this); return retval;}
+  CRGB &operator++() {addToRGB(1); return *this;}
+  CRGB operator++(int) {CRGB retval(*this); ++(*this); return retval;}
+  CRGB &operator/=(uint8_t d) {r /= d; g /= d; b /= d; return *this;}
+  CRGB &operator>>=(uint8_t d) {r >>= d; g >>= d; b >>= d; return *this;}
+  CRGB &operator*=(uint8_t d) {r = qmul8(r, d); g = qmul8(g, d); b = qmul8(b, d); return *this;}
+  CRGB &nscale8_video(uint8_t scaledown) {nscale8x3_video(r, g, b, scaledown); return *this;}
+  CRGB &operator%=(uint8_t scaledown) {nscale8x3_video(r, g, b, scaledown); return *this;}
+  CRGB &fadeLightBy(uint8_t fadefactor) {nscale8x3_video(r, g, b, 255 - fadefactor); return *this;}
+  CRGB &nscale8(uint8_t scaledown) {nscale8x3(r, g, b, scaledown); return *this;}
+  CRGB &nscale8(const CRGB &scaledown) {r = ::scale8(r, scaledown.r); g = ::scale8(g, scaledown.g); b = ::scale8(b, scaledown.b); return *this;}
+  CRGB scale8(uint8_t scaledown) const {CRGB out = *this; nscale8x3(out.r, out.g, out.b, scaledown); return out;}
+  CRGB scale8(const CRGB &scaledown) const {CRGB out; out.r = ::scale8(r, scaledown.r); out.g = ::scale8(g, scaledown.g); out.b = ::scale8(b, scaledown.b); return out;}
+  CRGB &fadeToBlackBy(uint8_t fadefactor) {nscale8x3(r, g, b, 255 - fadefactor); return *this;}
+  CRGB &operator|=(const CRGB &rhs) {if (rhs.r > r) r = rhs.r; if (rhs.g > g) g = rhs.g; if (rhs.b > b) b = rhs.b; return *this;}
+  CRGB &operator|=(uint8_t d) {if (d > r) r = d; if (d > g) g = d; if (d > b) b = d; return *this;}
+  CRGB &operator&=(const CRGB &rhs) {if (rhs.r < r) r = rhs.r; if (rhs.g < g) g = rhs.g; if (rhs.b < b) b = rhs.b; return *this;}
+  CRGB &operator&=(uint8_t d) {if (d < r) r = d; if (d < g) g = d; if (d < b) b = d; return *this;}
+  CRGB operator-() const {return CRGB(255 - r, 255 - g, 255 - b);}
+
+  explicit operator bool() const {return r || g || b;}
+  explicit operator uint32_t() const {return uint32_t{0xff000000} | (uint32_t{r} << 16) | (uint32_t{g} << 8) | uint32_t{b};}
+
+  uint8_t getLuma() const {return ::scale8(r, 54) + ::scale8(g, 183) + ::scale8(b, 18);}
+  uint8_t getAverageLight() const {return ::scale8(r, 85) + ::scale8(g, 85) + ::scale8(b, 85);}
+  void maximizeBrightness(uint8_t limit = 255) {
+    uint8_t max = r;
+    if (g > max) max = g;
+    if (b > max) max = b;
+    if (max == 0) return; //stop div/0 when color is black
+    uint16_t factor = ((uint16_t)(limit) * 256) / max;
+    r = (r * factor) / 256;
+    g = (g * factor) / 256;
+    b = (b * factor) / 256;
+  }
+  CRGB lerp8(const CRGB &other, fract8 frac) const {return CRGB(lerp8by8(r, other.r, frac), lerp8by8(g, other.g, frac), lerp8by8(b, other.b, frac));}
+};
+
+inline bool operator==(const CRGB &lhs, const CRGB &rhs) {return (lhs.r == rhs.r) && (lhs.g == rhs.g) && (lhs.b == rhs.b);}
+inline bool operator!=(const CRGB &lhs, const CRGB &rhs) {return !(lhs == rhs);}
+inline bool operator<(const CRGB &lhs, const CRGB &rhs) {return (lhs.r + lhs.g + lhs.b) < (rhs.r + rhs.g + rhs.b);}
+inline bool operator>(const CRGB &lhs, const CRGB &rhs) {return (lhs.r + lhs.g + lhs.b) > (rhs.r + rhs.g + rhs.b);}
+inline bool operator<=(const CRGB &lhs, const CRGB &rhs) {return (lhs.r + lhs.g + lhs.b) <= (rhs.r + rhs.g + rhs.b);}
+inline bool operator>=(const CRGB &lhs, const CRGB &rhs) {return (lhs.r + lhs.g + lhs.b) >= (rhs.r + rhs.g + rhs.b);}
+inline CRGB operator+(const CRGB &p1, const CRGB &p2) {return CRGB(qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b));}
+inline CRGB operator-(const CRGB &p1, const CRGB &p2) {return CRGB(qsub8(p1.r, p2.r), qsub8(p1.g, p2.g), qsub8(p1.b, p2.b));}
+inline CRGB operator*(const CRGB &p1, uint8_t d) {return CRGB(qmul8(p1.r, d), qmul8(p1.g, d), qmul8(p1.b, d));}
+inline CRGB operator/(const CRGB &p1, uint8_t d) {return CRGB(p1.r / d, p1.g / d, p1.b / d);}
+inline CRGB operator&(const CRGB &p1, const CRGB &p2) {return CRGB(p1.r < p2.r ? p1.r : p2.r, p1.g < p2.g ? p1.g : p2.g, p1.b < p2.b ? p1.b : p2.b);}
+inline CRGB operator|(const CRGB &p1, const CRGB &p2) {return CRGB(p1.r > p2.r ? p1.r : p2.r, p1.g > p2.g ? p1.g : p2.g, p1.b > p2.b ? p1.b : p2.b);}
+inline CRGB operator%(const CRGB &p1, uint8_t d) {CRGB retval(p1); retval.nscale8_video(d); return retval;}
+
+inline void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+  const uint8_t K255 = 255, K171 = 171, K170 = 170, K85 = 85;
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset = hue & 0x1F; //0..31
+  uint8_t offset8 = offset << 3;
+  uint8_t third = scale8(offset8, (256 / 3)); //max = 85
+
+  uint8_t r, g, b;
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {r = K255 - third; g = third; b = 0;} //000 R -> O
+      else {r = K171; g = K85 + third; b = 0;} //001 O -> Y
+    } else {
+      if (!(hue & 0x20)) {uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); r = K171 - twothirds; g = K170 + third; b = 0;} //010 Y -> G
+      else {r = 0; g = K255 - third; b = third;} //011 G -> A
+    }
+  } else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {r = 0; uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); g = K171 - twothirds; b = K85 + twothirds;} //100 A -> B
+      else {r = third; g = 0; b = K255 - third;} //101 B -> P
+    } else {
+      if (!(hue & 0x20)) {r = K85 + third; g = 0; b = K171 - third;} //110 P -> K
+      else {r = K170 + third; g = 0; b = K85 - third;} //111 K -> R
+    }
+  }
+
+  //scale down colors if we're desaturated at all and add the brightness_floor to r, g, and b
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255; b = 255; g = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      r = scale8(r, satscale);
+      g = scale8(g, satscale);
+      b = scale8(b, satscale);
+      uint8_t brightness_floor = desat;
+      r += brightness_floor;
+      g += brightness_floor;
+      b += brightness_floor;
+    }
+  }
+
+  //now scale everything down if we're at value < 255
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0; g = 0; b = 0;
+    } else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+inline void hsv2rgb_rainbow(const CHSV *phsv, CRGB *prgb, int numLeds) {for (int i = 0; i < numLeds; ++i) hsv2rgb_rainbow(phsv[i], prgb[i]);}
+
+//not the FastLED approximation but a plain conversion, close enough for the effects using it
+inline CHSV rgb2hsv_approximate(const CRGB &rgb) {
+  uint8_t max = rgb.r > rgb.g ? (rgb.r > rgb.b ? rgb.r : rgb.b) : (rgb.g > rgb.b ? rgb.g : rgb.b);
+  uint8_t min = rgb.r < rgb.g ? (rgb.r < rgb.b ? rgb.r : rgb.b) : (rgb.g < rgb.b ? rgb.g : rgb.b);
+  if (max == 0) return CHSV(0, 0, 0);
+  uint8_t delta = max - min;
+  uint8_t sat = 255 * delta / max;
+  if (delta == 0) return CHSV(0, 0, max);
+  int hue;
+  if (max == rgb.r) hue = 43 * (rgb.g - rgb.b) / delta;
+  else if (max == rgb.g) hue = 85 + 43 * (rgb.b - rgb.r) / delta;
+  else hue = 171 + 43 * (rgb.r - rgb.g) / delta;
+  return CHSV((uint8_t)hue, sat, max);
+}
+
+inline CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2) {
+  return CRGB(blend8(p1.r, p2.r, amountOfP2), blend8(p1.g, p2.g, amountOfP2), blend8(p1.b, p2.b, amountOfP2));
+}
+inline CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay) {
+  if (amountOfOverlay == 0) return existing;
+  if (amountOfOverlay == 255) {existing = overlay; return existing;}
+  existing.r = blend8(existing.r, overlay.r, amountOfOverlay);
+  existing.g = blend8(existing.g, overlay.g, amountOfOverlay);
+  existing.b = blend8(existing.b, overlay.b, amountOfOverlay);
+  return existing;
+}
+
+inline CRGB HeatColor(uint8_t temperature) {
+  CRGB heatcolor;
+  uint8_t t192 = scale8_video(temperature, 191);
+  uint8_t heatramp = t192 & 0x3F; //0..63
+  heatramp <<= 2; //scale up to 0..252
+  if (t192 & 0x80) {heatcolor.r = 255; heatcolor.g = 255; heatcolor.b = heatramp;} //hottest
+  else if (t192 & 0x40) {heatcolor.r = 255; heatcolor.g = heatramp; heatcolor.b = 0;} //middle
+  else {heatcolor.r = heatramp; heatcolor.g = 0; heatcolor.b = 0;} //coolest
+  return heatcolor;
+}
+
+inline void fill_solid(CRGB *targetArray, int numToFill, const CRGB &color) {for (int i = 0; i < numToFill; ++i) targetArray[i] = color;}
+inline void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue = 5) {
+  CHSV hsv(initialhue, 240, 255);
+  for (int i = 0; i < numToFill; ++i) {
+    targetArray[i] = hsv;
+    hsv.hue += deltahue;
+  }
+}
+inline void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale) {for (uint16_t i = 0; i < num_leds; ++i) leds[i].nscale8(scale);}
+inline void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy) {nscale8(leds, num_leds, 255 - fadeBy);}
+inline void fadeLightBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy) {for (uint16_t i = 0; i < num_leds; ++i) leds[i].fadeLightBy(fadeBy);}
+inline void blur1d(CRGB *leds, uint16_t numLeds, fract8 blur_amount) {
+  uint8_t keep = 255 - blur_amount;
+  uint8_t seep = blur_amount >> 1;
+  CRGB carryover = CRGB::Black;
+  for (uint16_t i = 0; i < numLeds; ++i) {
+    CRGB cur = leds[i];
+    CRGB part = cur;
+    part.nscale8(seep);
+    cur.nscale8(keep);
+    cur += carryover;
+    if (i) leds[i - 1] += part;
+    leds[i] = cur;
+    carryover = part;
+  }
+}
+
+//palettes
+
+typedef uint32_t TProgmemRGBPalette16[16];
+typedef enum {NOBLEND = 0, LINEARBLEND = 1, LINEARBLEND_NOWRAP = 2} TBlendType;
+
+class CRGBPalette16 {
+public:
+  CRGB entries[16];
+  CRGBPalette16() {}
+  CRGBPalette16(const CRGB &c00, const CRGB &c01, const CRGB &c02, const CRGB &c03, const CRGB &c04, const CRGB &c05, const CRGB &c06, const CRGB &c07,
+                const CRGB &c08, const CRGB &c09, const CRGB &c10, const CRGB &c11, const CRGB &c12, const CRGB &c13, const CRGB &c14, const CRGB &c15) {
+    entries[0] = c00; entries[1] = c01; entries[2] = c02; entries[3] = c03; entries[4] = c04; entries[5] = c05; entries[6] = c06; entries[7] = c07;
+    entries[8] = c08; entries[9] = c09; entries[10] = c10; entries[11] = c11; entries[12] = c12; entries[13] = c13; entries[14] = c14; entries[15] = c15;
+  }
+  CRGBPalette16(const TProgmemRGBPalette16 &rhs) {for (uint8_t i = 0; i < 16; ++i) entries[i] = rhs[i];}
+  CRGBPalette16 &operator=(const TProgmemRGBPalette16 &rhs) {for (uint8_t i = 0; i < 16; ++i) entries[i] = rhs[i]; return *this;}
+  CRGBPalette16(const CRGB &c1) {fill_solid(entries, 16, c1);}
+  bool operator==(const CRGBPalette16 &rhs) const {return memcmp(entries, rhs.entries, sizeof(entries)) == 0;}
+  bool operator!=(const CRGBPalette16 &rhs) const {return !(*this == rhs);}
+  CRGB &operator[](uint8_t x) {return entries[x];}
+  const CRGB &operator[](uint8_t x) const {return entries[x];}
+  operator CRGB *() {return &(entries[0]);}
+};
+
+inline CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND) {
+  if (blendType == LINEARBLEND_NOWRAP) index = map8(index, 0, 239); //blend range is affected by lo4 blend of values, remap to avoid wrapping
+
+  uint8_t hi4 = index >> 4;
+  uint8_t lo4 = index & 0x0F;
+
+  const CRGB *entry = &(pal[0]) + hi4;
+  uint8_t red1 = entry->red;
+  uint8_t green1 = entry->green;
+  uint8_t blue1 = entry->blue;
+
+  if (lo4 && (blendType != NOBLEND)) {
+    if (hi4 == 15) entry = &(pal[0]);
+    else ++entry;
+
+    uint8_t f2 = lo4 << 4;
+    uint8_t f1 = 255 - f2;
+
+    red1 = scale8(red1, f1) + scale8(entry->red, f2);
+    green1 = scale8(green1, f1) + scale8(entry->green, f2);
+    blue1 = scale8(blue1, f1) + scale8(entry->blue, f2);
+  }
+
+  if (brightness != 255) {
+    if (brightness) {
+      ++brightness; //adjust for rounding
+      red1 = scale8(red1, brightness);
+      green1 = scale8(green1, brightness);
+      blue1 = scale8(blue1, brightness);
+    } else {
+      red1 = 0; green1 = 0; blue1 = 0;
+    }
+  }
+
+  return CRGB(red1, green1, blue1);
+}
+
+inline const TProgmemRGBPalette16 CloudColors_p = {
+  CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue, CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue};
+inline const TProgmemRGBPalette16 LavaColors_p = {
+  CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon, CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange, CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed};
+inline const TProgmemRGBPalette16 OceanColors_p = {
+  CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy, CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+  CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue, CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue};
+inline const TProgmemRGBPalette16 ForestColors_p = {
+  CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen, CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+  CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen, CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen};
+inline const TProgmemRGBPalette16 RainbowColors_p = {
+  0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+  0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B};
+inline const TProgmemRGBPalette16 RainbowStripeColors_p = {
+  0xFF0000, 0x000000, 0xAB5500, 0x000000, 0xABAB00, 0x000000, 0x00FF00, 0x000000,
+  0x00AB55, 0x000000, 0x0000FF, 0x000000, 0x5500AB, 0x000000, 0xAB0055, 0x000000};
+inline const TProgmemRGBPalette16 PartyColors_p = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9};
+inline const TProgmemRGBPalette16 HeatColors_p = {
+  0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+  0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF};
+
+//controllers: nothing to drive on the host
+
+enum LEDColorCorrection : uint32_t {TypicalSMD5050 = 0xFFB0F0, TypicalLEDStrip = 0xFFB0F0, Typical8mmPixel = 0xFFE08C, UncorrectedColor = 0xFFFFFF};
+
+class CFastLED {
+  uint8_t brightness = 255;
+  uint32_t maxPowerInMilliWatts = 0;
+public:
+  void show() {}
+  void clear(bool = false) {}
+  void setBrightness(uint8_t scale) {brightness = scale;}
+  uint8_t getBrightness() const {return brightness;}
+  void setMaxPowerInMilliWatts(uint32_t milliwatts) {maxPowerInMilliWatts = milliwatts;}
+  void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) {setMaxPowerInMilliWatts(volts * milliamps);}
+};
+
+inline CFastLED FastLED;
@@ -0,0 +1,44 @@
+/*
+   @title     StarLight
+   @file      HardwareSerial.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) Serial: prints to stdout
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdarg>
+
+#define printf_P printf
+
+class HardwareSerial {
+public:
+  void begin(unsigned long) {}
+  void end() {}
+  void flush() {fflush(stdout);}
+  void setDebugOutput(bool) {}
+  int available() {return 0;}
+  int read() {return -1;}
+  size_t write(uint8_t c) {return fputc(c, stdout) == EOF ? 0 : 1;}
+  size_t print(const char *s) {return fputs(s, stdout) == EOF ? 0 : strlen(s);}
+  size_t println(const char *s = "") {size_t n = print(s); return n + print("\n");}
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n < 0 ? 0 : n;
+  }
+  explicit operator bool() const {return true;}
+};
+
+inline HardwareSerial Serial;
@@ -0,0 +1,182 @@
+/*
+   @title     StarLight
+   @file      LittleFS.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) LittleFS: a flat directory on the pc acts as the file system root
+//root is $STARLIGHT_NATIVE_FS or ./native_fs (created on begin)
+//size is $STARLIGHT_NATIVE_FS_KB or 256 KB (the 4MB boards partition, 16MB boards have 9 MB)
+
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class File {
+  struct Impl {
+    FILE *f = nullptr;
+    bool dir = false;
+    std::vector<std::string> entries; //directory entries, sorted like LittleFS lists them
+    size_t nextEntry = 0;
+    std::string path; //path relative to root, starting with /
+    std::string hostPath;
+    ~Impl() {
+      if (f) fclose(f);
+    }
+  };
+  std::shared_ptr<Impl> impl;
+
+public:
+  File() {}
+  static File openHost(const std::string &path, const std::string &hostPath, const char *mode) {
+    File file;
+    struct stat st;
+    if (stat(hostPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      DIR *dir = opendir(hostPath.c_str());
+      if (!dir) return file;
+      file.impl = std::make_shared<Impl>();
+      file.impl->dir = true;
+      while (struct dirent *entry = readdir(dir))
+        if (entry->d_name[0] != '.') file.impl->entries.push_back(entry->d_name);
+      closedir(dir);
+      std::sort(file.impl->entries.begin(), file.impl->entries.end());
+    } else {
+      FILE *f = fopen(hostPath.c_str(), mode);
+      if (!f) return file;
+      file.impl = std::make_shared<Impl>();
+      file.impl->f = f;
+    }
+    file.impl->path = path;
+    file.impl->hostPath = hostPath;
+    return file;
+  }
+
+  explicit operator bool() const {return impl && (impl->f || impl->dir);}
+  void close() {impl.reset();}
+
+  //reading
+  int read() {return (impl && impl->f) ? fgetc(impl->f) : -1;}
+  size_t read(uint8_t *buf, size_t size) {return (impl && impl->f && size) ? fread(buf, 1, size, impl->f) : 0;}
+  size_t readBytes(char *buf, size_t size) {return read((uint8_t *)buf, size);}
+  size_t readBytesUntil(char terminator, char *buf, size_t size) {
+    size_t n = 0;
+    while (n < size) {
+      int c = read();
+      if (c < 0 || c == terminator) break;
+      buf[n++] = c;
+    }
+    return n;
+  }
+  String readStringUntil(char terminator) {
+    String line;
+    for (int c = read(); c >= 0 && c != terminator; c = read()) line += (char)c;
+    return line;
+  }
+  int peek() {
+    if (!impl || !impl->f) return -1;
+    int c = fgetc(impl->f);
+    if (c != EOF) ungetc(c, impl->f);
+    return c;
+  }
+  int available() {
+    if (!impl || !impl->f) return 0;
+    long pos = ftell(impl->f);
+    return size() - pos;
+  }
+  bool seek(uint32_t pos) {return impl && impl->f && fseek(impl->f, pos, SEEK_SET) == 0;}
+  size_t position() const {return (impl && impl->f) ? ftell(impl->f) : 0;}
+  size_t size() const {
+    struct stat st;
+    if (impl && impl->f) fflush(impl->f);
+    return (impl && stat(impl->hostPath.c_str(), &st) == 0) ? st.st_size : 0;
+  }
+
+  //writing
+  size_t write(uint8_t c) {return (impl && impl->f && fputc(c, impl->f) != EOF) ? 1 : 0;}
+  size_t write(const uint8_t *buf, size_t size) {return (impl && impl->f && size) ? fwrite(buf, 1, size, impl->f) : 0;}
+  size_t print(const char *s) {return write((const uint8_t *)s, strlen(s));}
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    if (!impl || !impl->f) return 0;
+    va_list args;
+    va_start(args, format);
+    int n = vfprintf(impl->f, format, args);
+    va_end(args);
+    return n < 0 ? 0 : n;
+  }
+  void flush() {if (impl && impl->f) fflush(impl->f);}
+
+  //directories
+  const char *name() const {
+    if (!impl) return "";
+    size_t slash = impl->path.find_last_of('/');
+    return impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+  }
+  const char *path() const {return impl ? impl->path.c_str() : "";}
+  bool isDirectory() const {return impl && impl->dir;}
+  time_t getLastWrite() {
+    struct stat st;
+    return (impl && stat(impl->hostPath.c_str(), &st) == 0) ? st.st_mtime : 0;
+  }
+  File openNextFile() {
+    if (!impl || !impl->dir) return File();
+    if (impl->nextEntry >= impl->entries.size()) return File();
+    const std::string &entry = impl->entries[impl->nextEntry++];
+    std::string base = impl->path == "/" ? "" : impl->path;
+    return openHost(base + "/" + entry, impl->hostPath + "/" + entry, FILE_READ);
+  }
+};
+
+class FS {
+  std::string root;
+
+public:
+  bool begin(bool formatOnFail = false) {
+    const char *env = getenv("STARLIGHT_NATIVE_FS");
+    root = env ? env : "native_fs";
+    ::mkdir(root.c_str(), 0755);
+    struct stat st;
+    return stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+  }
+  const char *hostRoot() const {return root.c_str();}
+
+  File open(const char *path, const char *mode = FILE_READ, const bool create = false) {
+    std::string p = (path && path[0] == '/') ? path : std::string("/") + (path ? path : "");
+    return File::openHost(p, root + (p == "/" ? "" : p), mode);
+  }
+  File open(const String &path, const char *mode = FILE_READ, const bool create = false) {return open(path.c_str(), mode, create);}
+  bool exists(const char *path) {struct stat st; return stat((root + "/" + path).c_str(), &st) == 0;}
+  bool remove(const char *path) {return ::remove((root + "/" + path).c_str()) == 0;}
+  bool rename(const char *from, const char *to) {return ::rename((root + "/" + from).c_str(), (root + "/" + to).c_str()) == 0;}
+  bool mkdir(const char *path) {return ::mkdir((root + "/" + path).c_str(), 0755) == 0;}
+  size_t totalBytes() {
+    const char *env = getenv("STARLIGHT_NATIVE_FS_KB");
+    return (env ? atoi(env) : 256) * 1024;
+  }
+  size_t usedBytes() {
+    size_t used = 0;
+    File dir = open("/");
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) used += file.size();
+    return used;
+  }
+};
+
+} //namespace fs
+
+using fs::File;
+
+inline fs::FS LittleFS;
@@ -0,0 +1,29 @@
+/*
+   @title     StarLight
+   @file      Wire.h
+   @date      20241219
+   @repo      https://github.com/MoonModules/StarLight
+   @Authors   https://github.com/MoonModules/StarLight/commits/main
+   @Copyright © 2024 Github StarLight Commit Authors
+   @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+   @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+*/
+
+//Host (env:native) I2C: there is no bus, begin always fails so I2C users fall back gracefully
+
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {return false;}
+  void beginTransmission(uint8_t) {}
+  uint8_t endTransmission(bool = true) {return 2;} //address send, NACK received
+  size_t write(uint8_t) {return 0;}
+  uint8_t requestFrom(uint8_t, uint8_t) {return 0;}
+  int available() {return 0;}
+  int read() {return -1;}
+};
+
+inline TwoWire Wire;
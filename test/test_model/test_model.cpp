@@ -0,0 +1,66 @@
+#include "unity.h"
+
+#include "../native/HostStubs.h"
+#include "Sys/SysModModel.h"
+#include "Sys/SysModUI.h"
+#include "Sys/SysModWeb.h"
+
+void setUp(void) {
+  if (mdl == nullptr) hostSetup(); //coalesceChanges on, the test runs on the loop task
+}
+
+void tearDown(void) {}
+
+static uint8_t boundValue = 0;
+static unsigned onChanges = 0;
+
+void test_model_coalesced_bound_value(void) {
+  Variable moduleVar = mdl->initVar(Variable(), "TestModel", "module");
+  Variable slider = ui->initSlider(moduleVar, "bound", &boundValue, 0, 255, false, [](EventArguments) { switch (eventType) {
+    case onChange:
+      onChanges++;
+      return true;
+    default: return false;
+  }});
+  mdl->loop();
+  onChanges = 0;
+
+  slider.setValue((uint8_t)10);
+  TEST_ASSERT_EQUAL(10, boundValue); //right away, not after the dispatch
+  slider.setValue((uint8_t)20);
+  TEST_ASSERT_EQUAL(20, boundValue);
+  TEST_ASSERT_EQUAL(0, onChanges); //coalesced
+
+  mdl->loop(); //dispatch
+  TEST_ASSERT_EQUAL(1, onChanges);
+  TEST_ASSERT_EQUAL(20, boundValue);
+  web->sendResponseObject(); //drop the ui responses
+}
+
+void test_model_var_index_collision(void) {
+  Variable moduleVar = mdl->initVar(Variable(), "TestIndex", "module");
+  Variable first = mdl->initVar(moduleVar, "first", "number");
+  Variable second = mdl->initVar(moduleVar, "second", "number");
+  uint16_t count = mdl->varIndexCount;
+
+  //both in the same slot with the same hash: the second probes on, the first is not evicted
+  uint32_t hash = 12345;
+  mdl->varIndexAdd(hash, first.var);
+  mdl->varIndexAdd(hash, second.var);
+  mdl->varIndexAdd(hash, first.var); //same var again: no new entry
+  TEST_ASSERT_EQUAL(count + 2, mdl->varIndexCount);
+  unsigned found = 0;
+  for (SysModModel::VarIndexEntry &entry: mdl->varIndex)
+    if (entry.hash == hash) found++;
+  TEST_ASSERT_EQUAL(2, found);
+
+  TEST_ASSERT_TRUE(mdl->findVar("TestIndex", "first") == first.var);
+  TEST_ASSERT_TRUE(mdl->findVar("TestIndex", "second") == second.var);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_model_coalesced_bound_value);
+  RUN_TEST(test_model_var_index_collision);
+  return UNITY_END();
+}
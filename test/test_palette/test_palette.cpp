@@ -0,0 +1,36 @@
+#include "unity.h"
+
+#include "App/LedLayer.h"
+
+void setUp(void) {
+  if (print == nullptr) print = new SysModPrint(); //LedsLayer logs via ppf
+}
+
+void tearDown(void) {}
+
+static void checkPalette(LedsLayer &leds, const CRGBPalette16 &palette) {
+  leds.palette = palette;
+  leds.paletteChanged();
+  for (int index = 0; index < 256; index++) {
+    for (int brightness = 0; brightness < 256; brightness++) {
+      CRGB expected = ColorFromPalette(palette, index, brightness);
+      CRGB color = leds.colorFromPalette(index, brightness);
+      TEST_ASSERT_EQUAL(expected.r, color.r);
+      TEST_ASSERT_EQUAL(expected.g, color.g);
+      TEST_ASSERT_EQUAL(expected.b, color.b);
+    }
+  }
+}
+
+void test_palette_lut(void) {
+  LedsLayer *leds = new LedsLayer(); //not deleted: the destructor clears the leds of the fixture, which is not there
+  checkPalette(*leds, RainbowColors_p);
+  checkPalette(*leds, HeatColors_p);
+  checkPalette(*leds, CloudColors_p);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_palette_lut);
+  return UNITY_END();
+}
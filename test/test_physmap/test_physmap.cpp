@@ -0,0 +1,69 @@
+#include "unity.h"
+
+#include "App/LedLayer.h"
+
+typedef PhysMapT<uint16_t, 14> PhysMapCompact;
+typedef PhysMapT<uint32_t, 30> PhysMapWide;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+template <typename Map>
+static void checkIndexes(uint32_t maxIndex) {
+  Map map;
+  TEST_ASSERT_EQUAL(m_color, map.mapType);
+
+  map.indexP = maxIndex;
+  map.mapType = m_onePixel;
+  TEST_ASSERT_EQUAL(maxIndex, map.indexP);
+  TEST_ASSERT_EQUAL(m_onePixel, map.mapType);
+
+  map.indexes = maxIndex - 1;
+  map.mapType = m_morePixels;
+  TEST_ASSERT_EQUAL(maxIndex - 1, map.indexes);
+  TEST_ASSERT_EQUAL(m_morePixels, map.mapType);
+}
+
+void test_physmap_compact(void) {
+  TEST_ASSERT_EQUAL(2, sizeof(PhysMapCompact));
+  checkIndexes<PhysMapCompact>(16383);
+
+  PhysMapCompact map;
+  map.setRGB(CRGB(255, 128, 0));
+  CRGB color = map.getRGB();
+  TEST_ASSERT_EQUAL(m_color, map.mapType);
+  TEST_ASSERT_UINT8_WITHIN(8, 255, color.r); //554 RGB
+  TEST_ASSERT_UINT8_WITHIN(8, 128, color.g);
+  TEST_ASSERT_UINT8_WITHIN(16, 0, color.b);
+}
+
+void test_physmap_wide(void) {
+  TEST_ASSERT_EQUAL(4, sizeof(PhysMapWide));
+  checkIndexes<PhysMapWide>(65535);
+
+  PhysMapWide map;
+  map.setRGB(CRGB(255, 128, 7));
+  CRGB color = map.getRGB();
+  TEST_ASSERT_EQUAL(m_color, map.mapType);
+  TEST_ASSERT_EQUAL_UINT8(255, color.r); //888 RGB
+  TEST_ASSERT_EQUAL_UINT8(128, color.g);
+  TEST_ASSERT_EQUAL_UINT8(7, color.b);
+}
+
+void test_physmap_selected(void) {
+  #ifdef STARLIGHT_PHYSMAP_WIDE
+    TEST_ASSERT_EQUAL(sizeof(PhysMapWide), sizeof(PhysMap));
+  #else
+    TEST_ASSERT_EQUAL(sizeof(PhysMapCompact), sizeof(PhysMap));
+  #endif
+  TEST_ASSERT_TRUE(STARLIGHT_MAXLEDS <= 16384 || sizeof(PhysMap) == 4);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_physmap_compact);
+  RUN_TEST(test_physmap_wide);
+  RUN_TEST(test_physmap_selected);
+  return UNITY_END();
+}
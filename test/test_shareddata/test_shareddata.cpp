@@ -0,0 +1,72 @@
+#include "unity.h"
+
+#include "App/LedLayer.h"
+
+void setUp(void) {
+  if (print == nullptr) print = new SysModPrint(); //SharedData logs via ppf
+}
+
+void tearDown(void) {}
+
+void test_shareddata_aligned(void) {
+  SharedData data;
+  uint8_t *byte1 = data.readWrite<uint8_t>();
+  uint32_t *word = data.readWrite<uint32_t>();
+  Coord3D *coord = data.readWrite<Coord3D>();
+  TEST_ASSERT_NOT_NULL(byte1);
+  TEST_ASSERT_EQUAL(0, (uintptr_t)word % alignof(uint32_t));
+  TEST_ASSERT_EQUAL(0, (uintptr_t)coord % alignof(Coord3D));
+  TEST_ASSERT_EQUAL(20, (SharedData::sizeOf<uint8_t, uint32_t, Coord3D>()));
+}
+
+void test_shareddata_grow_keeps_contents(void) {
+  SharedData data;
+  uint8_t *control = data.write<uint8_t>(42); //as an effect setup binds a control
+  data.begin();
+  TEST_ASSERT_EQUAL_PTR(control, data.readWrite<uint8_t>());
+  uint32_t *state = data.readWrite<uint32_t>(100); //grows past the first chunk
+  TEST_ASSERT_NOT_NULL(state);
+  TEST_ASSERT_EQUAL(0, state[99]);
+  state[0] = 7;
+  TEST_ASSERT_EQUAL(42, *control); //not moved, not cleared
+
+  data.begin();
+  TEST_ASSERT_EQUAL_PTR(control, data.readWrite<uint8_t>());
+  TEST_ASSERT_EQUAL(7, data.readWrite<uint32_t>(100)[0]);
+}
+
+void test_shareddata_reserve(void) {
+  SharedData data;
+  data.reserve(SharedData::sizeOf<uint8_t, uint32_t[50]>());
+  uint16_t allocated = data.bytesAllocated;
+  data.readWrite<uint8_t>();
+  data.readWrite<uint32_t>(50);
+  TEST_ASSERT_EQUAL(allocated, data.bytesAllocated); //fits in the reserved chunk
+}
+
+void test_shareddata_block(void) {
+  SharedData data;
+  uint8_t *control = data.write<uint8_t>(1);
+  uint16_t *grid = data.readWrite<uint16_t>(sharedDataBlockBytes); //large array: own block
+  uint8_t *after = data.readWrite<uint8_t>();
+  TEST_ASSERT_NOT_NULL(grid);
+  TEST_ASSERT_EQUAL(2 * sharedDataBlockBytes, data.blockBytes);
+  TEST_ASSERT_EQUAL_PTR(control + 1, after); //small state stays together
+  grid[0] = 1234;
+
+  data.begin();
+  data.readWrite<uint8_t>();
+  grid = data.readWrite<uint16_t>(2 * sharedDataBlockBytes); //size changed: contents kept
+  TEST_ASSERT_EQUAL(1234, grid[0]);
+  TEST_ASSERT_EQUAL(0, grid[2 * sharedDataBlockBytes - 1]);
+  TEST_ASSERT_EQUAL_PTR(after, data.readWrite<uint8_t>());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_shareddata_aligned);
+  RUN_TEST(test_shareddata_grow_keeps_contents);
+  RUN_TEST(test_shareddata_reserve);
+  RUN_TEST(test_shareddata_block);
+  return UNITY_END();
+}
@@ -0,0 +1,89 @@
+#include "unity.h"
+
+#include "Sys/SysModFiles.h"
+#include "Sys/SysModPrint.h"
+#include "Sys/SysStarJson.h"
+
+#include <vector>
+
+void setUp(void) {
+  if (print == nullptr) print = new SysModPrint(); //StarJson logs via ppf
+  if (files == nullptr) files = new SysModFiles();
+}
+
+void tearDown(void) {}
+
+static void writeFile(const char *fileName, const char *json) {
+  File f = files->open(fileName, "w");
+  f.print(json);
+  f.close();
+}
+
+void test_starjson_fixture(void) {
+  writeFile("/F_test.json", "{\"name\":\"test \\\"quoted\\\"\",\"factor\":10,\"outputs\":[{\"pin\":2,\"leds\":[[0,10,20],[30,40,50]]},{\"pin\":3,\"leds\":[[60,70,80]]}]}");
+
+  uint8_t factor = 0, pin = 0;
+  char name[32] = "";
+  std::vector<float> pixels;
+  std::vector<uint8_t> pins;
+  StarJson starJson("/F_test.json");
+  starJson.lookFor("name", name);
+  starJson.lookFor("factor", &factor);
+  starJson.lookFor("pin", &pin);
+  starJson.lookFor("leds", [&](const float *numbers, uint8_t count) {
+    if (count == 0) pins.push_back(pin); //end of leds array
+    for (uint8_t i = 0; i < count; i++) pixels.push_back(numbers[i]);
+  });
+  TEST_ASSERT_TRUE(starJson.deserialize());
+
+  TEST_ASSERT_EQUAL_STRING("test \"quoted\"", name);
+  TEST_ASSERT_EQUAL(10, factor);
+  TEST_ASSERT_EQUAL(9, pixels.size());
+  for (int i = 0; i < 9; i++) TEST_ASSERT_EQUAL(i * 10, (int)pixels[i]);
+  TEST_ASSERT_EQUAL(2, pins.size());
+  TEST_ASSERT_EQUAL(2, pins[0]);
+  TEST_ASSERT_EQUAL(3, pins[1]);
+}
+
+void test_starjson_numbers(void) {
+  writeFile("/numbers.json", "{\"list\": [ -12, 3.5, -0.25, 1e3, 65535 ]}");
+
+  std::vector<float> numbers;
+  StarJson starJson("/numbers.json");
+  starJson.lookFor("list", [&](const float *values, uint8_t count) {
+    numbers.assign(values, values + count);
+  });
+  TEST_ASSERT_TRUE(starJson.deserialize());
+
+  TEST_ASSERT_EQUAL(5, numbers.size());
+  TEST_ASSERT_EQUAL_FLOAT(-12, numbers[0]);
+  TEST_ASSERT_EQUAL_FLOAT(3.5, numbers[1]);
+  TEST_ASSERT_EQUAL_FLOAT(-0.25, numbers[2]);
+  TEST_ASSERT_EQUAL_FLOAT(1000, numbers[3]);
+  TEST_ASSERT_EQUAL_FLOAT(65535, numbers[4]);
+}
+
+void test_starjson_blocks(void) {
+  //larger than the read buffer and deeper than the stack: ids are found across block boundaries
+  String json = "{\"filler\":\"";
+  for (int i = 0; i < starJsonBufferSize; i++) json += "x";
+  json += "\",\"deep\":";
+  for (int i = 0; i < starJsonDepth + 2; i++) json += "[";
+  for (int i = 0; i < starJsonDepth + 2; i++) json += "]";
+  json += ",\"factor\":7}";
+  writeFile("/blocks.json", json.c_str());
+
+  uint8_t factor = 0;
+  StarJson starJson("/blocks.json");
+  starJson.lookFor("factor", &factor);
+  TEST_ASSERT_TRUE(starJson.deserialize());
+  TEST_ASSERT_EQUAL(7, factor);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_starjson_fixture);
+  RUN_TEST(test_starjson_numbers);
+  RUN_TEST(test_starjson_blocks);
+  return UNITY_END();
+}
@@ -0,0 +1,60 @@
+# @title     StarLight
+# @file      fixture2bin.py
+# @date      20241219
+# @repo      https://github.com/MoonModules/StarLight
+# @Authors   https://github.com/MoonModules/StarLight/commits/main
+# @Copyright © 2024 Github StarLight Commit Authors
+# @license   GNU GENERAL PUBLIC LICENSE Version 3, 29 June 2007
+# @license   For non GPL-v3 usage, commercial licenses must be purchased. Contact moonmodules@icloud.com
+
+# Convert F_*.json fixtures to the binary fixture format read by LedModFixture::mapFixtureBin (same as the Fixture toBinary button)
+# usage: python3 tools/fixture2bin.py data/F_Panel.json [more.json ...] -> data/F_Panel.bin
+# layout (little endian): header, pixels (x,y,z uint16 in pin order), pins (pin, reserved, nr of pixels)
+
+import json
+import os
+import struct
+import sys
+
+FIXTURE_BIN_VERSION = 1
+HEADER = "<4sBBBBHHHHBB" # magic, version, ledFactor, ledSize, ledShape, size x,y,z, nrOfLeds, nrOfPins, reserved
+PIN = "<BBH"
+PIXEL = "<HHH"
+
+def convert(jsonName):
+    with open(jsonName) as f:
+        fixture = json.load(f)
+
+    factor = fixture.get("factor", 1)
+    pixels = bytearray()
+    pins = bytearray()
+    maxPixel = [0, 0, 0]
+    nrOfLeds = 0
+    nrOfPins = 0
+    for output in fixture.get("outputs", []):
+        leds = output.get("leds", [])
+        for led in leds:
+            pixel = (list(led) + [0, 0, 0])[:3] # 1D and 2D fixtures: missing coordinates are 0
+            maxPixel = [max(m, p) for m, p in zip(maxPixel, pixel)]
+            pixels += struct.pack(PIXEL, *pixel)
+        pins += struct.pack(PIN, output.get("pin", 0), 0, len(leds))
+        nrOfLeds += len(leds)
+        nrOfPins += 1
+
+    if nrOfLeds > 65535 or nrOfPins > 255 or factor < 1:
+        raise ValueError("%s: %d pixels, %d pins, factor %d not supported" % (jsonName, nrOfLeds, nrOfPins, factor))
+
+    size = [m // factor + 1 for m in maxPixel] # as LedModFixture::addPixelsPost pass 1
+    header = struct.pack(HEADER, b"SLFX", FIXTURE_BIN_VERSION, factor, fixture.get("ledSize", 4), fixture.get("shape", 0), *size, nrOfLeds, nrOfPins, 0)
+
+    binName = os.path.splitext(jsonName)[0] + ".bin"
+    with open(binName, "wb") as f:
+        f.write(header + pixels + pins)
+    print("%s -> %s %d pixels %d pins size %s" % (jsonName, binName, nrOfLeds, nrOfPins, size))
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: fixture2bin.py F_fixture.json [...]")
+        sys.exit(1)
+    for name in sys.argv[1:]:
+        convert(name)